@@ -0,0 +1,73 @@
+#include "bench.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef BENCH_REVISION
+#define BENCH_REVISION "unknown"
+#endif
+
+static const char* benchSuite = "";
+static const char* benchFilter = NULL;
+static double benchMinTime = BENCH_MIN_TIME;
+static FILE* benchOut = NULL;
+
+bool BenchInit(const char* suite, int argc, char* argv[]) {
+    benchSuite = suite;
+    benchOut = stdout;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            benchOut = fopen(argv[++i], "w");
+            if (!benchOut) { fprintf(stderr, "bench: cannot write %s\n", argv[i]); return false; }
+        }
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) benchFilter = argv[++i];
+        else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) benchMinTime = atof(argv[++i]);
+    }
+    return true;
+}
+
+static int CompareDouble(const void* a, const void* b) {
+    double da = *(const double*)a, db = *(const double*)b;
+    return (da > db) - (da < db);
+}
+
+static double TimeBench(BenchFunc func, void* ctx, long iterations) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    func(ctx, iterations);
+    return (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+void RunBench(const char* name, BenchFunc func, void* ctx) {
+    if (benchFilter && !strstr(name, benchFilter)) return;
+
+    long iterations = 1;
+    for (;;) {
+        double t = TimeBench(func, ctx, iterations);
+        if (t >= benchMinTime || iterations >= (1L << 40)) break;
+        long next = t > 0 ? (long)(iterations * benchMinTime * 1.2 / t) : iterations * 100;
+        iterations = next > iterations * 100 ? iterations * 100 : (next > iterations ? next : iterations * 2);
+    }
+
+    double ns[BENCH_SAMPLES];
+    for (int s = 0; s < BENCH_SAMPLES; s++) ns[s] = TimeBench(func, ctx, iterations) * 1e9 / (double)iterations;
+    qsort(ns, BENCH_SAMPLES, sizeof(double), CompareDouble);
+
+    fprintf(benchOut, "{\"suite\":\"%s\",\"name\":\"%s\",\"revision\":\"%s\",\"iterations\":%ld,\"samples\":%d,"
+            "\"ns_min\":%.3f,\"ns_median\":%.3f,\"ns_max\":%.3f}\n",
+            benchSuite, name, BENCH_REVISION, iterations, BENCH_SAMPLES, ns[0], ns[BENCH_SAMPLES / 2], ns[BENCH_SAMPLES - 1]);
+    fflush(benchOut);
+}
+
+void SkipBench(const char* name, const char* reason) {
+    if (benchFilter && !strstr(name, benchFilter)) return;
+    fprintf(benchOut, "{\"suite\":\"%s\",\"name\":\"%s\",\"revision\":\"%s\",\"skipped\":\"",
+            benchSuite, name, BENCH_REVISION);
+    for (const char* c = reason; *c; c++) fputc((*c == '"' || *c == '\\' || *c < ' ') ? '\'' : *c, benchOut);
+    fprintf(benchOut, "\"}\n");
+}
+
+void BenchFinish(void) {
+    if (benchOut && benchOut != stdout) fclose(benchOut);
+    benchOut = NULL;
+}
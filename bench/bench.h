@@ -0,0 +1,16 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdbool.h>
+
+#define BENCH_SAMPLES 7
+#define BENCH_MIN_TIME 0.05
+
+typedef void (*BenchFunc)(void* ctx, long iterations);
+
+bool BenchInit(const char* suite, int argc, char* argv[]);
+void RunBench(const char* name, BenchFunc func, void* ctx);
+void SkipBench(const char* name, const char* reason);
+void BenchFinish(void);
+
+#endif
@@ -0,0 +1,203 @@
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+#include "camera.h"
+#include "hud.h"
+#include "level.h"
+#include "particles.h"
+#include "sim.h"
+#include "text.h"
+
+#define RECT_SET 1024
+
+static volatile float sinkF;
+static volatile int sinkI;
+
+typedef struct {
+    RectF a[RECT_SET], b[RECT_SET];
+} RectSet;
+
+typedef struct {
+    const Level* level;
+    SimState sim;
+} PlayerBench;
+
+typedef struct {
+    SDL_Renderer* renderer;
+    GlyphAtlas* atlas;
+} TextBench;
+
+static uint32_t NextRandom(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    return *state = x;
+}
+
+static void BenchCheckCol(void* ctx, long iterations) {
+    const RectSet* set = ctx;
+    int hits = 0;
+    for (long i = 0; i < iterations; i++) {
+        int k = (int)(i & (RECT_SET - 1));
+        hits += checkCol(set->a[k], set->b[k]);
+    }
+    sinkI = hits;
+}
+
+static void BenchLerpSmoothing(void* ctx, long iterations) {
+    Camera* cam = ctx;
+    float scaleX = 1.3f, scaleY = 0.7f;
+    const float dt = 1.0f / 120.0f;
+    for (long i = 0; i < iterations; i++) {
+        float t = (float)(i & 1023);
+        UpdateCamera(cam, t * 4.0f, t * 0.5f, dt);
+        scaleX = Lerp(scaleX, 1.0f, 15.0f * dt);
+        scaleY = Lerp(scaleY, 1.0f, 15.0f * dt);
+        if ((i & 63) == 0) { scaleX = 1.3f; scaleY = 0.7f; }
+    }
+    sinkF = cam->x + cam->y + scaleX + scaleY;
+}
+
+static void BenchTouchToGame(void* ctx, long iterations) {
+    (void)ctx;
+    float sum = 0.0f;
+    for (long i = 0; i < iterations; i++) {
+        float u = (float)(i & 255) / 255.0f;
+        float v = (float)((i >> 8) & 255) / 255.0f;
+        float x, y;
+        TouchToGameCoords(2400, 1080, 800, 360, u, v, &x, &y);
+        sum += x + y;
+    }
+    sinkF = sum;
+}
+
+static void BenchPlayerStep(void* ctx, long iterations) {
+    PlayerBench* b = ctx;
+    const float dt = 1.0f / 120.0f;
+    for (long i = 0; i < iterations; i++) {
+        uint64_t tick = b->sim.tick;
+        int phase = (int)(tick % 480);
+        SimInput in = {0};
+        in.right = phase < 240;
+        in.left = phase >= 240;
+        in.jumpPressed = (tick % 90) == 0;
+        in.jumpHeld = (tick % 90) < 20;
+        in.dashPressed = (tick % 150) == 75;
+        in.attackPressed = (tick % 200) == 130;
+        SimStep(&b->sim, b->level, &in, dt);
+    }
+    sinkF = b->sim.player.x;
+}
+
+static void BenchGhostTrail(void* ctx, long iterations) {
+    ParticlePool* pool = ctx;
+    const float dt = 1.0f / 120.0f;
+    ParticleDesc d = {0};
+    d.alpha = 0.6f; d.fade = 3.0f;
+    d.size = DRAW_SIZE;
+    d.frameX = 340; d.frameY = 40;
+    d.color = 0xFFFFFF;
+    for (long i = 0; i < iterations; i++) {
+        d.x = (float)(i & 1023); d.y = 200.0f;
+        d.flip = (uint8_t)(i & 1);
+        EmitParticle(pool, &d);
+        UpdateParticles(pool, dt);
+    }
+    sinkI = pool->count;
+}
+
+static void BenchTextCached(void* ctx, long iterations) {
+    TextBench* b = ctx;
+    SDL_Color cWhite = {255, 255, 255, 255};
+    for (long i = 0; i < iterations; i++) {
+        RenderText(b->renderer, b->atlas, "00:12:34", 630, 10, cWhite, true);
+        if ((i & 255) == 255) SDL_RenderFlush(b->renderer);
+    }
+    SDL_RenderFlush(b->renderer);
+}
+
+static void BenchTextChanging(void* ctx, long iterations) {
+    TextBench* b = ctx;
+    SDL_Color cWhite = {255, 255, 255, 255};
+    char buffer[32];
+    for (long i = 0; i < iterations; i++) {
+        long cs = i % 360000;
+        snprintf(buffer, sizeof(buffer), "%02ld:%02ld:%02ld", cs / 6000, (cs / 100) % 60, cs % 100);
+        RenderText(b->renderer, b->atlas, buffer, 630, 10, cWhite, true);
+        if ((i & 255) == 255) SDL_RenderFlush(b->renderer);
+    }
+    SDL_RenderFlush(b->renderer);
+}
+
+static void RunTextBenches(const char* fontPath) {
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    if (SDL_Init(SDL_INIT_VIDEO) != 0 || TTF_Init() != 0) {
+        SkipBench("render_text", SDL_GetError());
+        return;
+    }
+
+    SDL_Window* window = SDL_CreateWindow("bench", 0, 0, 640, 360, SDL_WINDOW_HIDDEN);
+    SDL_Renderer* renderer = window ? SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE) : NULL;
+    TTF_Font* font = TTF_OpenFont(fontPath, 24);
+    GlyphAtlas* atlas = (renderer && font) ? CreateGlyphAtlas(renderer, font) : NULL;
+
+    if (atlas) {
+        TextBench b = { renderer, atlas };
+        RunBench("render_text_cached", BenchTextCached, &b);
+        RunBench("render_text_changing", BenchTextChanging, &b);
+    } else {
+        SkipBench("render_text", font ? SDL_GetError() : "font not found");
+    }
+
+    DestroyGlyphAtlas(atlas);
+    if (font) TTF_CloseFont(font);
+    if (renderer) SDL_DestroyRenderer(renderer);
+    if (window) SDL_DestroyWindow(window);
+    TTF_Quit();
+    SDL_Quit();
+}
+
+int main(int argc, char* argv[]) {
+    const char* fontPath = "PixelAE-Bold.ttf";
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--font") == 0 && i + 1 < argc) fontPath = argv[++i];
+    }
+    if (!BenchInit("micro", argc, argv)) return 1;
+
+    static RectSet rects;
+    uint32_t seed = 0x9E3779B9u;
+    for (int k = 0; k < RECT_SET; k++) {
+        rects.a[k] = (RectF){ (float)(NextRandom(&seed) % 640), (float)(NextRandom(&seed) % 360), 20, 40 };
+        rects.b[k] = (RectF){ (float)(NextRandom(&seed) % 640), (float)(NextRandom(&seed) % 360), 96, 16 };
+    }
+    RunBench("check_col", BenchCheckCol, &rects);
+
+    Camera cam;
+    SnapCamera(&cam, 0, 0);
+    RunBench("lerp_smoothing", BenchLerpSmoothing, &cam);
+
+    RunBench("touch_to_game", BenchTouchToGame, NULL);
+
+    Level* level = CreateDefaultLevel();
+    if (level) {
+        static PlayerBench player;
+        player.level = level;
+        SimInit(&player.sim, level);
+        RunBench("player_step", BenchPlayerStep, &player);
+        FreeLevel(level);
+    } else {
+        SkipBench("player_step", "no level");
+    }
+
+    static ParticlePool ghosts;
+    ClearParticles(&ghosts);
+    RunBench("ghost_spawn_update", BenchGhostTrail, &ghosts);
+
+    RunTextBenches(fontPath);
+
+    BenchFinish();
+    return 0;
+}
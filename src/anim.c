@@ -0,0 +1,52 @@
+#include "anim.h"
+#include "sim.h"
+
+const AnimFrame animFrames[] = {
+    { ARMED_OFFSET_X, 40 }, { ARMED_OFFSET_X + 20, 40 },
+    { ARMED_OFFSET_X, 140 }, { ARMED_OFFSET_X + 20, 140 }, { ARMED_OFFSET_X + 40, 140 }, { ARMED_OFFSET_X + 60, 140 },
+    { 200, 140 },
+    { 220, 140 },
+    { 240, 140 },
+    { 300, 40 }, { 320, 40 }, { 340, 40 }, { 360, 40 },
+    { 340, 40 },
+};
+
+const AnimClip animClips[ANIM_COUNT] = {
+    [ANIM_IDLE]   = { 0, 2, ANIM_LOOP, 0.3f },
+    [ANIM_RUN]    = { 2, 4, ANIM_LOOP, 0.1f },
+    [ANIM_RISE]   = { 6, 1, ANIM_LOOP, 1.0f },
+    [ANIM_AIR]    = { 7, 1, ANIM_LOOP, 1.0f },
+    [ANIM_FALL]   = { 8, 1, ANIM_LOOP, 1.0f },
+    [ANIM_ATTACK] = { 9, 4, 0, 0.08f },
+    [ANIM_DASH]   = { 13, 1, ANIM_LOOP, 1.0f },
+};
+
+void PlayAnim(uint8_t* clip, uint8_t* frame, float* timer, int next) {
+    if (*clip == next) return;
+    *clip = (uint8_t)next;
+    *frame = 0;
+    *timer = 0;
+}
+
+void AdvanceAnims(const uint8_t* clip, uint8_t* frame, float* timer, int count, float dt) {
+    for (int i = 0; i < count; i++) {
+        const AnimClip* c = &animClips[clip[i]];
+        float t = timer[i] + dt;
+        if (t >= c->frameTime) {
+            t -= c->frameTime;
+            int f = frame[i] + 1;
+            if (f >= c->count) f = (c->flags & ANIM_LOOP) ? 0 : c->count;
+            frame[i] = (uint8_t)f;
+        }
+        timer[i] = t;
+    }
+}
+
+bool AnimFinished(int clip, int frame) {
+    return frame >= animClips[clip].count;
+}
+
+AnimFrame AnimSource(int clip, int frame) {
+    const AnimClip* c = &animClips[clip];
+    return animFrames[c->first + (frame < c->count ? frame : c->count - 1)];
+}
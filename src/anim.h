@@ -0,0 +1,41 @@
+#ifndef ANIM_H
+#define ANIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+enum {
+    ANIM_IDLE,
+    ANIM_RUN,
+    ANIM_RISE,
+    ANIM_AIR,
+    ANIM_FALL,
+    ANIM_ATTACK,
+    ANIM_DASH,
+    ANIM_COUNT
+};
+
+enum {
+    ANIM_LOOP = 1 << 0
+};
+
+typedef struct {
+    int16_t x, y;
+} AnimFrame;
+
+typedef struct {
+    uint8_t first;
+    uint8_t count;
+    uint8_t flags;
+    float frameTime;
+} AnimClip;
+
+extern const AnimFrame animFrames[];
+extern const AnimClip animClips[ANIM_COUNT];
+
+void PlayAnim(uint8_t* clip, uint8_t* frame, float* timer, int next);
+void AdvanceAnims(const uint8_t* clip, uint8_t* frame, float* timer, int count, float dt);
+bool AnimFinished(int clip, int frame);
+AnimFrame AnimSource(int clip, int frame);
+
+#endif
@@ -0,0 +1,123 @@
+#include "assets.h"
+#include <stdio.h>
+#include <string.h>
+
+static void LoadSprites(AssetLoader* l) {
+    const AssetManifest* m = &l->manifest;
+    const BundleEntry* pixels = FindBundleEntry(l->bundle, "sprites");
+    const BundleEntry* rects = FindBundleEntry(l->bundle, "sprites.rects");
+
+    if (pixels && rects && pixels->type == BUNDLE_RGBA32 &&
+        pixels->size == (uint64_t)pixels->w * pixels->h * 4 &&
+        rects->size == sizeof(SDL_Rect) * (uint64_t)(m->spriteCount + 1)) {
+        SDL_Surface* sheet = SDL_CreateRGBSurfaceWithFormat(0, (int)pixels->w, (int)pixels->h, 32, SDL_PIXELFORMAT_RGBA32);
+        if (sheet) {
+            const Uint8* src = BundleData(l->bundle, pixels);
+            for (int y = 0; y < sheet->h; y++) {
+                memcpy((Uint8*)sheet->pixels + y * sheet->pitch, src + (size_t)y * pixels->w * 4, pixels->w * 4);
+            }
+            const SDL_Rect* table = BundleData(l->bundle, rects);
+            memcpy(l->spriteRects, table, sizeof(SDL_Rect) * (size_t)m->spriteCount);
+            l->spriteWhite = table[m->spriteCount];
+            l->spriteSheet = sheet;
+            return;
+        }
+    }
+    l->spriteSheet = PackAtlasSurface(m->spriteSources, m->spriteCount, l->spriteRects, &l->spriteWhite);
+}
+
+static void LoadFont(AssetLoader* l) {
+    const BundleEntry* e = FindBundleEntry(l->bundle, "font");
+    if (e) l->font = TTF_OpenFontRW(SDL_RWFromConstMem(BundleData(l->bundle, e), (int)e->size), 1, l->manifest.fontSize);
+    if (!l->font) l->font = TTF_OpenFont(l->manifest.fontPath, l->manifest.fontSize);
+    l->glyphs = BuildGlyphAtlas(l->font);
+}
+
+static void LoadMusic(AssetLoader* l) {
+    const BundleEntry* e = FindBundleEntry(l->bundle, "music");
+    if (e) l->music = Mix_LoadMUS_RW(SDL_RWFromConstMem(BundleData(l->bundle, e), (int)e->size), 1);
+    if (!l->music) l->music = Mix_LoadMUS(l->manifest.musicPath);
+}
+
+static int AssetWorker(void* data) {
+    AssetJob* job = data;
+    switch (job->id) {
+        case ASSET_SPRITES: LoadSprites(job->loader); break;
+        case ASSET_FONT:    LoadFont(job->loader); break;
+        case ASSET_MUSIC:   LoadMusic(job->loader); break;
+    }
+    SDL_AtomicSet(&job->loader->ready[job->id], 1);
+    return 0;
+}
+
+AssetLoader* StartAssetLoader(const AssetManifest* manifest) {
+    AssetLoader* l = SDL_calloc(1, sizeof(AssetLoader));
+    if (!l) return NULL;
+    l->manifest = *manifest;
+    if (manifest->bundlePath) l->bundle = OpenBundle(manifest->bundlePath);
+
+    static const char* names[ASSET_COUNT] = { "load-sprites", "load-font", "load-music" };
+    for (int i = 0; i < ASSET_COUNT; i++) {
+        l->jobs[i] = (AssetJob){ l, i };
+        l->workers[i] = SDL_CreateThread(AssetWorker, names[i], &l->jobs[i]);
+        if (!l->workers[i]) AssetWorker(&l->jobs[i]);
+    }
+    return l;
+}
+
+bool TakeAsset(AssetLoader* loader, int id) {
+    if (loader->taken[id] || !SDL_AtomicGet(&loader->ready[id])) return false;
+    if (loader->workers[id]) {
+        SDL_WaitThread(loader->workers[id], NULL);
+        loader->workers[id] = NULL;
+    }
+    loader->taken[id] = true;
+    return true;
+}
+
+int AssetsPending(AssetLoader* loader) {
+    int pending = 0;
+    for (int i = 0; i < ASSET_COUNT; i++) pending += !loader->taken[i];
+    return pending;
+}
+
+void FreeAssetLoader(AssetLoader* loader) {
+    if (!loader) return;
+    for (int i = 0; i < ASSET_COUNT; i++) {
+        if (loader->workers[i]) SDL_WaitThread(loader->workers[i], NULL);
+    }
+    if (loader->spriteSheet) SDL_FreeSurface(loader->spriteSheet);
+    if (!loader->taken[ASSET_FONT]) {
+        DestroyGlyphAtlas(loader->glyphs);
+        if (loader->font) TTF_CloseFont(loader->font);
+    }
+    if (!loader->taken[ASSET_MUSIC] && loader->music) Mix_FreeMusic(loader->music);
+    CloseBundle(loader->bundle);
+    SDL_free(loader);
+}
+
+bool BakeAssetBundle(const AssetManifest* manifest, const char* path) {
+    SDL_Rect rects[ATLAS_MAX_ENTRIES + 1];
+    SDL_Surface* sheet = PackAtlasSurface(manifest->spriteSources, manifest->spriteCount, rects, &rects[manifest->spriteCount]);
+    if (!sheet) return false;
+
+    size_t fontSize = 0, musicSize = 0;
+    void* font = SDL_LoadFile(manifest->fontPath, &fontSize);
+    void* music = SDL_LoadFile(manifest->musicPath, &musicSize);
+
+    BundleItem items[4];
+    int count = 0;
+    items[count++] = (BundleItem){ "sprites", BUNDLE_RGBA32, (uint32_t)sheet->w, (uint32_t)sheet->h,
+                                   sheet->pixels, (uint64_t)sheet->w * sheet->h * 4 };
+    items[count++] = (BundleItem){ "sprites.rects", BUNDLE_BLOB, 0, 0, rects, sizeof(SDL_Rect) * (uint64_t)(manifest->spriteCount + 1) };
+    if (font) items[count++] = (BundleItem){ "font", BUNDLE_BLOB, 0, 0, font, fontSize };
+    if (music) items[count++] = (BundleItem){ "music", BUNDLE_BLOB, 0, 0, music, musicSize };
+
+    bool ok = sheet->pitch == sheet->w * 4 && WriteBundle(path, items, count);
+    if (ok) printf("bundle: wrote %d entries to %s\n", count, path);
+
+    SDL_free(font);
+    SDL_free(music);
+    SDL_FreeSurface(sheet);
+    return ok;
+}
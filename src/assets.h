@@ -0,0 +1,58 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+
+#include "atlas.h"
+#include "bundle.h"
+#include "text.h"
+
+enum {
+    ASSET_SPRITES,
+    ASSET_FONT,
+    ASSET_MUSIC,
+    ASSET_COUNT
+};
+
+typedef struct {
+    const char* bundlePath;
+    const AtlasSource* spriteSources;
+    int spriteCount;
+    const char* fontPath;
+    int fontSize;
+    const char* musicPath;
+} AssetManifest;
+
+struct AssetLoader;
+
+typedef struct {
+    struct AssetLoader* loader;
+    int id;
+} AssetJob;
+
+typedef struct AssetLoader {
+    AssetManifest manifest;
+    Bundle* bundle;
+    AssetJob jobs[ASSET_COUNT];
+    SDL_Thread* workers[ASSET_COUNT];
+    SDL_atomic_t ready[ASSET_COUNT];
+    bool taken[ASSET_COUNT];
+
+    SDL_Surface* spriteSheet;
+    SDL_Rect spriteRects[ATLAS_MAX_ENTRIES];
+    SDL_Rect spriteWhite;
+    TTF_Font* font;
+    GlyphAtlas* glyphs;
+    Mix_Music* music;
+} AssetLoader;
+
+AssetLoader* StartAssetLoader(const AssetManifest* manifest);
+bool TakeAsset(AssetLoader* loader, int id);
+int AssetsPending(AssetLoader* loader);
+void FreeAssetLoader(AssetLoader* loader);
+bool BakeAssetBundle(const AssetManifest* manifest, const char* path);
+
+#endif
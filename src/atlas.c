@@ -0,0 +1,116 @@
+#include "atlas.h"
+#include <SDL2/SDL_image.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ATLAS_PADDING 2
+#define ATLAS_WHITE_SIZE 4
+#define ATLAS_MAX_SIZE 8192
+
+static SDL_Surface* LoadSurface(const AtlasSource* src) {
+    SDL_Surface* loaded = IMG_Load(src->path);
+    if (!loaded) {
+        SDL_Surface* fallback = SDL_CreateRGBSurfaceWithFormat(0, 32, 32, 32, SDL_PIXELFORMAT_RGBA32);
+        SDL_FillRect(fallback, NULL, SDL_MapRGBA(fallback->format, 255, 0, 255, 255));
+        return fallback;
+    }
+    if (src->colorKey) {
+        SDL_SetColorKey(loaded, SDL_TRUE, SDL_MapRGB(loaded->format, 0, 0, 0));
+    }
+    return loaded;
+}
+
+static bool PackShelves(SDL_Surface** surfs, const int* order, int count, int width, SDL_Rect* out, int* outHeight) {
+    int penX = ATLAS_PADDING, penY = ATLAS_PADDING, rowH = 0;
+    for (int k = 0; k <= count; k++) {
+        int w = (k < count) ? surfs[order[k]]->w : ATLAS_WHITE_SIZE;
+        int h = (k < count) ? surfs[order[k]]->h : ATLAS_WHITE_SIZE;
+        if (w + 2 * ATLAS_PADDING > width) return false;
+        if (penX + w + ATLAS_PADDING > width) {
+            penX = ATLAS_PADDING;
+            penY += rowH + ATLAS_PADDING;
+            rowH = 0;
+        }
+        out[k] = (SDL_Rect){ penX, penY, w, h };
+        penX += w + ATLAS_PADDING;
+        if (h > rowH) rowH = h;
+    }
+    *outHeight = penY + rowH + ATLAS_PADDING;
+    return true;
+}
+
+SDL_Surface* PackAtlasSurface(const AtlasSource* sources, int count, SDL_Rect* rects, SDL_Rect* white) {
+    if (count > ATLAS_MAX_ENTRIES) count = ATLAS_MAX_ENTRIES;
+
+    SDL_Surface* surfs[ATLAS_MAX_ENTRIES];
+    int order[ATLAS_MAX_ENTRIES];
+    for (int i = 0; i < count; i++) {
+        surfs[i] = LoadSurface(&sources[i]);
+        order[i] = i;
+    }
+
+    for (int i = 1; i < count; i++) {
+        int v = order[i], j = i - 1;
+        while (j >= 0 && surfs[order[j]]->h < surfs[v]->h) { order[j + 1] = order[j]; j--; }
+        order[j + 1] = v;
+    }
+
+    SDL_Rect placed[ATLAS_MAX_ENTRIES + 1];
+    int width = 256, height = 0;
+    while (!PackShelves(surfs, order, count, width, placed, &height) || height > width) {
+        width *= 2;
+        if (width > ATLAS_MAX_SIZE) {
+            for (int i = 0; i < count; i++) SDL_FreeSurface(surfs[i]);
+            SDL_SetError("atlas too large");
+            return NULL;
+        }
+    }
+
+    SDL_Surface* sheet = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+    if (sheet) {
+        SDL_FillRect(sheet, NULL, SDL_MapRGBA(sheet->format, 0, 0, 0, 0));
+        for (int k = 0; k < count; k++) {
+            int id = order[k];
+            rects[id] = placed[k];
+            SDL_Rect dst = placed[k];
+            SDL_SetSurfaceBlendMode(surfs[id], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(surfs[id], NULL, sheet, &dst);
+        }
+        SDL_Rect patch = placed[count];
+        SDL_FillRect(sheet, &patch, SDL_MapRGBA(sheet->format, 255, 255, 255, 255));
+        *white = (SDL_Rect){ patch.x + 1, patch.y + 1, ATLAS_WHITE_SIZE - 2, ATLAS_WHITE_SIZE - 2 };
+    }
+    for (int i = 0; i < count; i++) SDL_FreeSurface(surfs[i]);
+    return sheet;
+}
+
+TextureAtlas* CreateTextureAtlas(SDL_Renderer* r, SDL_Surface* sheet, const SDL_Rect* rects, int count, SDL_Rect white) {
+    if (!sheet) return NULL;
+    if (count > ATLAS_MAX_ENTRIES) count = ATLAS_MAX_ENTRIES;
+
+    TextureAtlas* atlas = calloc(1, sizeof(TextureAtlas));
+    if (!atlas) return NULL;
+    atlas->tex = SDL_CreateTextureFromSurface(r, sheet);
+    if (!atlas->tex) {
+        free(atlas);
+        return NULL;
+    }
+    SDL_SetTextureBlendMode(atlas->tex, SDL_BLENDMODE_BLEND);
+    atlas->w = sheet->w;
+    atlas->h = sheet->h;
+    atlas->count = count;
+    memcpy(atlas->rects, rects, sizeof(SDL_Rect) * (size_t)count);
+    atlas->white = white;
+    return atlas;
+}
+
+void DestroyTextureAtlas(TextureAtlas* atlas) {
+    if (!atlas) return;
+    SDL_DestroyTexture(atlas->tex);
+    free(atlas);
+}
+
+SDL_Rect AtlasRegion(const TextureAtlas* atlas, int id, int x, int y, int w, int h) {
+    const SDL_Rect* base = &atlas->rects[id];
+    return (SDL_Rect){ base->x + x, base->y + y, w, h };
+}
@@ -0,0 +1,27 @@
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+#define ATLAS_MAX_ENTRIES 32
+
+typedef struct {
+    const char* path;
+    bool colorKey;
+} AtlasSource;
+
+typedef struct {
+    SDL_Texture* tex;
+    int w, h;
+    int count;
+    SDL_Rect rects[ATLAS_MAX_ENTRIES];
+    SDL_Rect white;
+} TextureAtlas;
+
+SDL_Surface* PackAtlasSurface(const AtlasSource* sources, int count, SDL_Rect* rects, SDL_Rect* white);
+TextureAtlas* CreateTextureAtlas(SDL_Renderer* r, SDL_Surface* sheet, const SDL_Rect* rects, int count, SDL_Rect white);
+void DestroyTextureAtlas(TextureAtlas* atlas);
+SDL_Rect AtlasRegion(const TextureAtlas* atlas, int id, int x, int y, int w, int h);
+
+#endif
@@ -0,0 +1,138 @@
+#include "audio.h"
+#include <SDL2/SDL_mixer.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* sfxFiles[SFX_COUNT] = { "jump.wav", "land.wav", "dash.wav", "attack.wav" };
+
+static bool LoadClip(SfxClip* clip, const char* path, int channels) {
+    Mix_Chunk* chunk = Mix_LoadWAV(path);
+    if (!chunk) return false;
+    clip->frames = (int)(chunk->alen / (sizeof(int16_t) * (Uint32)channels));
+    clip->pcm = malloc((size_t)clip->frames * (size_t)channels * sizeof(int16_t));
+    if (clip->pcm) memcpy(clip->pcm, chunk->abuf, (size_t)clip->frames * (size_t)channels * sizeof(int16_t));
+    Mix_FreeChunk(chunk);
+    return clip->pcm != NULL;
+}
+
+static bool SynthClip(SfxClip* clip, int kind, int freq, int channels) {
+    float seconds = kind == SFX_LAND ? 0.08f : kind == SFX_ATTACK ? 0.09f : kind == SFX_DASH ? 0.16f : 0.12f;
+    clip->frames = (int)(seconds * freq);
+    clip->pcm = malloc((size_t)clip->frames * (size_t)channels * sizeof(int16_t));
+    if (!clip->pcm) return false;
+
+    uint32_t noise = 0x12345678u;
+    float phase = 0.0f;
+    for (int i = 0; i < clip->frames; i++) {
+        float t = (float)i / (float)clip->frames;
+        float env = (1.0f - t) * (1.0f - t);
+        float s;
+        noise = noise * 1664525u + 1013904223u;
+        float white = (float)(noise >> 8) / 8388608.0f - 1.0f;
+        if (kind == SFX_JUMP) {
+            phase += (300.0f + 500.0f * t) / freq;
+            s = fmodf(phase, 1.0f) < 0.5f ? 0.5f : -0.5f;
+        } else if (kind == SFX_ATTACK) {
+            phase += (900.0f - 500.0f * t) / freq;
+            s = fmodf(phase, 1.0f) < 0.25f ? 0.5f : -0.5f;
+        } else if (kind == SFX_DASH) {
+            s = white * 0.4f * (1.0f - t);
+            env = 1.0f - t;
+        } else {
+            s = white * 0.6f;
+            env *= env;
+        }
+        int16_t v = (int16_t)(s * env * 12000.0f);
+        for (int c = 0; c < channels; c++) clip->pcm[i * channels + c] = v;
+    }
+    return true;
+}
+
+static void MixVoices(void* data, Uint8* stream, int len) {
+    SfxMixer* m = data;
+
+    int tail = SDL_AtomicGet(&m->tail);
+    int head = SDL_AtomicGet(&m->head);
+    for (; tail != head; tail++) {
+        const SfxCommand* cmd = &m->queue[(unsigned)tail % SFX_QUEUE_SIZE];
+        SfxVoice* v = NULL;
+        for (int i = 0; i < SFX_MAX_VOICES; i++) {
+            SfxVoice* c = &m->voices[i];
+            if (c->clip < 0) { v = c; break; }
+            if (!v || c->pos > v->pos) v = c;
+        }
+        v->clip = cmd->clip;
+        v->pos = 0;
+        v->gainL = cmd->gainL;
+        v->gainR = cmd->gainR;
+    }
+    SDL_AtomicSet(&m->tail, tail);
+
+    int16_t* out = (int16_t*)stream;
+    int ch = m->channels;
+    int frames = len / (int)(sizeof(int16_t) * (size_t)ch);
+    for (int i = 0; i < SFX_MAX_VOICES; i++) {
+        SfxVoice* v = &m->voices[i];
+        if (v->clip < 0) continue;
+        const SfxClip* clip = &m->clips[v->clip];
+        int n = clip->frames - v->pos;
+        if (n > frames) n = frames;
+        const int16_t* src = clip->pcm + (size_t)v->pos * (size_t)ch;
+        for (int f = 0; f < n; f++) {
+            for (int c = 0; c < ch; c++) {
+                int32_t gain = (c & 1) ? v->gainR : v->gainL;
+                int32_t s = out[f * ch + c] + ((src[f * ch + c] * gain) >> 15);
+                out[f * ch + c] = (int16_t)(s > 32767 ? 32767 : s < -32768 ? -32768 : s);
+            }
+        }
+        v->pos += n;
+        if (v->pos >= clip->frames) v->clip = -1;
+    }
+}
+
+SfxMixer* CreateSfxMixer(void) {
+    int freq, channels;
+    Uint16 format;
+    if (!Mix_QuerySpec(&freq, &format, &channels)) return NULL;
+    if (format != AUDIO_S16SYS || channels < 1) {
+        SDL_Log("sfx: unsupported device format 0x%x, effects disabled", format);
+        return NULL;
+    }
+
+    SfxMixer* m = calloc(1, sizeof(SfxMixer));
+    if (!m) return NULL;
+    m->freq = freq;
+    m->channels = channels;
+    for (int i = 0; i < SFX_MAX_VOICES; i++) m->voices[i].clip = -1;
+    for (int k = 0; k < SFX_COUNT; k++) {
+        if (!LoadClip(&m->clips[k], sfxFiles[k], channels) && !SynthClip(&m->clips[k], k, freq, channels)) {
+            DestroySfxMixer(m);
+            return NULL;
+        }
+    }
+    Mix_SetPostMix(MixVoices, m);
+    return m;
+}
+
+void DestroySfxMixer(SfxMixer* mixer) {
+    if (!mixer) return;
+    Mix_SetPostMix(NULL, NULL);
+    for (int k = 0; k < SFX_COUNT; k++) free(mixer->clips[k].pcm);
+    free(mixer);
+}
+
+bool PlaySfx(SfxMixer* mixer, int clip, float volume, float pan) {
+    if (!mixer) return false;
+    int head = SDL_AtomicGet(&mixer->head);
+    if (head - SDL_AtomicGet(&mixer->tail) >= SFX_QUEUE_SIZE) return false;
+
+    if (pan < -1.0f) pan = -1.0f;
+    if (pan > 1.0f) pan = 1.0f;
+    SfxCommand* cmd = &mixer->queue[(unsigned)head % SFX_QUEUE_SIZE];
+    cmd->clip = (uint8_t)clip;
+    cmd->gainL = (int16_t)(volume * (pan > 0 ? 1.0f - pan : 1.0f) * 32767.0f);
+    cmd->gainR = (int16_t)(volume * (pan < 0 ? 1.0f + pan : 1.0f) * 32767.0f);
+    SDL_AtomicSet(&mixer->head, head + 1);
+    return true;
+}
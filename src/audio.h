@@ -0,0 +1,49 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define AUDIO_BUFFER 512
+#define SFX_MAX_VOICES 16
+#define SFX_QUEUE_SIZE 64
+
+enum {
+    SFX_JUMP,
+    SFX_LAND,
+    SFX_DASH,
+    SFX_ATTACK,
+    SFX_COUNT
+};
+
+typedef struct {
+    int16_t* pcm;
+    int frames;
+} SfxClip;
+
+typedef struct {
+    int clip;
+    int pos;
+    int32_t gainL, gainR;
+} SfxVoice;
+
+typedef struct {
+    uint8_t clip;
+    int16_t gainL, gainR;
+} SfxCommand;
+
+typedef struct {
+    int freq, channels;
+    SfxClip clips[SFX_COUNT];
+    SfxVoice voices[SFX_MAX_VOICES];
+
+    SDL_atomic_t head, tail;
+    SfxCommand queue[SFX_QUEUE_SIZE];
+} SfxMixer;
+
+SfxMixer* CreateSfxMixer(void);
+void DestroySfxMixer(SfxMixer* mixer);
+bool PlaySfx(SfxMixer* mixer, int clip, float volume, float pan);
+
+#endif
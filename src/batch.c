@@ -0,0 +1,52 @@
+#include "batch.h"
+#include <stdlib.h>
+
+SpriteBatch* CreateSpriteBatch(void) {
+    SpriteBatch* batch = calloc(1, sizeof(SpriteBatch));
+    if (!batch) return NULL;
+    for (int q = 0; q < BATCH_MAX_SPRITES; q++) {
+        int* idx = &batch->indices[q * 6];
+        int v = q * 4;
+        idx[0] = v; idx[1] = v + 1; idx[2] = v + 2;
+        idx[3] = v + 2; idx[4] = v + 3; idx[5] = v;
+    }
+    return batch;
+}
+
+void DestroySpriteBatch(SpriteBatch* batch) {
+    free(batch);
+}
+
+void BatchBegin(SpriteBatch* batch, SDL_Texture* tex) {
+    int w = 1, h = 1;
+    if (tex) SDL_QueryTexture(tex, NULL, NULL, &w, &h);
+    batch->tex = tex;
+    batch->invW = 1.0f / w;
+    batch->invH = 1.0f / h;
+    batch->count = 0;
+    batch->drawCalls = 0;
+}
+
+void BatchSprite(SpriteBatch* batch, SDL_Renderer* r, SDL_Rect src, SDL_FRect dst, SDL_RendererFlip flip, SDL_Color color) {
+    if (batch->count == BATCH_MAX_SPRITES) BatchFlush(batch, r);
+
+    float u0 = src.x * batch->invW, v0 = src.y * batch->invH;
+    float u1 = (src.x + src.w) * batch->invW, v1 = (src.y + src.h) * batch->invH;
+    if (flip & SDL_FLIP_HORIZONTAL) { float t = u0; u0 = u1; u1 = t; }
+    if (flip & SDL_FLIP_VERTICAL) { float t = v0; v0 = v1; v1 = t; }
+
+    float x0 = dst.x, y0 = dst.y, x1 = dst.x + dst.w, y1 = dst.y + dst.h;
+    SDL_Vertex* v = &batch->verts[batch->count * 4];
+    v[0] = (SDL_Vertex){ color, { x0, y0 }, { u0, v0 } };
+    v[1] = (SDL_Vertex){ color, { x1, y0 }, { u1, v0 } };
+    v[2] = (SDL_Vertex){ color, { x1, y1 }, { u1, v1 } };
+    v[3] = (SDL_Vertex){ color, { x0, y1 }, { u0, v1 } };
+    batch->count++;
+}
+
+void BatchFlush(SpriteBatch* batch, SDL_Renderer* r) {
+    if (batch->count == 0) return;
+    SDL_RenderGeometry(r, batch->tex, batch->verts, batch->count * 4, batch->indices, batch->count * 6);
+    batch->count = 0;
+    batch->drawCalls++;
+}
@@ -0,0 +1,23 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <SDL2/SDL.h>
+
+#define BATCH_MAX_SPRITES 8192
+
+typedef struct {
+    SDL_Texture* tex;
+    float invW, invH;
+    int count;
+    int drawCalls;
+    SDL_Vertex verts[BATCH_MAX_SPRITES * 4];
+    int indices[BATCH_MAX_SPRITES * 6];
+} SpriteBatch;
+
+SpriteBatch* CreateSpriteBatch(void);
+void DestroySpriteBatch(SpriteBatch* batch);
+void BatchBegin(SpriteBatch* batch, SDL_Texture* tex);
+void BatchSprite(SpriteBatch* batch, SDL_Renderer* r, SDL_Rect src, SDL_FRect dst, SDL_RendererFlip flip, SDL_Color color);
+void BatchFlush(SpriteBatch* batch, SDL_Renderer* r);
+
+#endif
@@ -0,0 +1,88 @@
+#include "bundle.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BUNDLE_ALIGN 16
+
+Bundle* OpenBundle(const char* path) {
+    MappedFile file;
+    if (!MapFile(path, &file)) return NULL;
+
+    const BundleHeader* hdr = file.data;
+    if (file.size < sizeof(BundleHeader) || hdr->magic != BUNDLE_MAGIC || hdr->version != BUNDLE_VERSION ||
+        hdr->count > (file.size - sizeof(BundleHeader)) / sizeof(BundleEntry)) {
+        fprintf(stderr, "bundle: %s has a bad header\n", path);
+        UnmapFile(&file);
+        return NULL;
+    }
+
+    const BundleEntry* entries = (const BundleEntry*)((const char*)file.data + sizeof(BundleHeader));
+    for (uint32_t i = 0; i < hdr->count; i++) {
+        if (entries[i].offset > file.size || entries[i].size > file.size - entries[i].offset) {
+            fprintf(stderr, "bundle: %s entry %u is out of range\n", path, i);
+            UnmapFile(&file);
+            return NULL;
+        }
+    }
+
+    Bundle* bundle = calloc(1, sizeof(Bundle));
+    if (!bundle) { UnmapFile(&file); return NULL; }
+    bundle->file = file;
+    bundle->count = hdr->count;
+    bundle->entries = entries;
+    return bundle;
+}
+
+void CloseBundle(Bundle* bundle) {
+    if (!bundle) return;
+    UnmapFile(&bundle->file);
+    free(bundle);
+}
+
+const BundleEntry* FindBundleEntry(const Bundle* bundle, const char* name) {
+    if (!bundle) return NULL;
+    for (uint32_t i = 0; i < bundle->count; i++) {
+        if (strncmp(bundle->entries[i].name, name, BUNDLE_NAME_LEN) == 0) return &bundle->entries[i];
+    }
+    return NULL;
+}
+
+const void* BundleData(const Bundle* bundle, const BundleEntry* entry) {
+    return (const char*)bundle->file.data + entry->offset;
+}
+
+bool WriteBundle(const char* path, const BundleItem* items, int count) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+
+    BundleHeader hdr = { BUNDLE_MAGIC, BUNDLE_VERSION, (uint32_t)count, 0 };
+    bool ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+
+    uint64_t offset = sizeof(BundleHeader) + sizeof(BundleEntry) * (uint64_t)count;
+    for (int i = 0; ok && i < count; i++) {
+        offset = (offset + BUNDLE_ALIGN - 1) & ~(uint64_t)(BUNDLE_ALIGN - 1);
+        BundleEntry e = {0};
+        strncpy(e.name, items[i].name, BUNDLE_NAME_LEN - 1);
+        e.type = items[i].type;
+        e.w = items[i].w;
+        e.h = items[i].h;
+        e.offset = offset;
+        e.size = items[i].size;
+        ok = fwrite(&e, sizeof(e), 1, f) == 1;
+        offset += items[i].size;
+    }
+
+    static const char zeros[BUNDLE_ALIGN] = {0};
+    uint64_t pos = sizeof(BundleHeader) + sizeof(BundleEntry) * (uint64_t)count;
+    for (int i = 0; ok && i < count; i++) {
+        uint64_t aligned = (pos + BUNDLE_ALIGN - 1) & ~(uint64_t)(BUNDLE_ALIGN - 1);
+        if (aligned > pos) ok = fwrite(zeros, 1, (size_t)(aligned - pos), f) == aligned - pos;
+        pos = aligned;
+        if (ok && items[i].size > 0) ok = fwrite(items[i].data, 1, (size_t)items[i].size, f) == items[i].size;
+        pos += items[i].size;
+    }
+
+    fclose(f);
+    return ok;
+}
@@ -0,0 +1,54 @@
+#ifndef BUNDLE_H
+#define BUNDLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mapfile.h"
+
+#define BUNDLE_MAGIC 0x314B4150u
+#define BUNDLE_VERSION 1
+#define BUNDLE_NAME_LEN 24
+
+enum {
+    BUNDLE_BLOB,
+    BUNDLE_RGBA32
+};
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+} BundleHeader;
+
+typedef struct {
+    char name[BUNDLE_NAME_LEN];
+    uint32_t type;
+    uint32_t w, h;
+    uint32_t reserved;
+    uint64_t offset;
+    uint64_t size;
+} BundleEntry;
+
+typedef struct {
+    const char* name;
+    uint32_t type;
+    uint32_t w, h;
+    const void* data;
+    uint64_t size;
+} BundleItem;
+
+typedef struct {
+    MappedFile file;
+    uint32_t count;
+    const BundleEntry* entries;
+} Bundle;
+
+Bundle* OpenBundle(const char* path);
+void CloseBundle(Bundle* bundle);
+const BundleEntry* FindBundleEntry(const Bundle* bundle, const char* name);
+const void* BundleData(const Bundle* bundle, const BundleEntry* entry);
+bool WriteBundle(const char* path, const BundleItem* items, int count);
+
+#endif
@@ -0,0 +1,20 @@
+#include "camera.h"
+#include "sim.h"
+
+void SnapCamera(Camera* cam, float targetX, float targetY) {
+    cam->x = cam->prevX = targetX;
+    cam->y = cam->prevY = targetY;
+}
+
+void UpdateCamera(Camera* cam, float targetX, float targetY, float dt) {
+    cam->prevX = cam->x; cam->prevY = cam->y;
+    float t = CAMERA_FOLLOW * dt;
+    if (t > 1.0f) t = 1.0f;
+    cam->x = Lerp(cam->x, targetX, t);
+    cam->y = Lerp(cam->y, targetY, t);
+}
+
+RectF CameraView(const Camera* cam, float interp, float w, float h) {
+    RectF view = { Lerp(cam->prevX, cam->x, interp), Lerp(cam->prevY, cam->y, interp), w, h };
+    return view;
+}
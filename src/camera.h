@@ -0,0 +1,17 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include "level.h"
+
+#define CAMERA_FOLLOW 8.0f
+
+typedef struct {
+    float x, y;
+    float prevX, prevY;
+} Camera;
+
+void SnapCamera(Camera* cam, float targetX, float targetY);
+void UpdateCamera(Camera* cam, float targetX, float targetY, float dt);
+RectF CameraView(const Camera* cam, float interp, float w, float h);
+
+#endif
@@ -0,0 +1,191 @@
+#include "capture.h"
+#include <SDL2/SDL_image.h>
+#include <stdlib.h>
+#include <string.h>
+
+static bool EncodeFrame(CaptureSession* c, const CaptureBuffer* b) {
+    if (c->format == CAPTURE_RAW) {
+        for (int y = 0; y < c->h; y++) {
+            if (fwrite(b->pixels + (size_t)y * c->pitch, 4, (size_t)c->w, c->stream) != (size_t)c->w) return false;
+        }
+        return true;
+    }
+
+    char name[CAPTURE_PATH_MAX + 32];
+    snprintf(name, sizeof(name), c->path, (int)b->frame);
+    SDL_Surface* s = SDL_CreateRGBSurfaceWithFormatFrom(b->pixels, c->w, c->h, 32, c->pitch, SDL_PIXELFORMAT_RGBA32);
+    if (!s) return false;
+    bool ok = IMG_SavePNG(s, name) == 0;
+    SDL_FreeSurface(s);
+    return ok;
+}
+
+static int EncoderThread(void* data) {
+    CaptureSession* c = data;
+    for (;;) {
+        SDL_SemWait(c->ready);
+        CaptureBuffer* b = &c->buffers[c->tail];
+        if (SDL_AtomicGet(&b->state) != CAPTURE_FILLED) {
+            if (SDL_AtomicGet(&c->quit)) break;
+            continue;
+        }
+        if (!SDL_AtomicGet(&c->failed) && !EncodeFrame(c, b)) SDL_AtomicSet(&c->failed, 1);
+        SDL_AtomicSet(&b->state, CAPTURE_FREE);
+        c->tail = (c->tail + 1) % CAPTURE_BUFFERS;
+    }
+    return 0;
+}
+
+static bool ValidTemplate(const char* path) {
+    int conversions = 0;
+    for (const char* p = path; *p; p++) {
+        if (*p != '%') continue;
+        if (p[1] == '%') { p++; continue; }
+        p++;
+        while (*p >= '0' && *p <= '9') p++;
+        if (*p != 'd') return false;
+        conversions++;
+    }
+    return conversions == 1;
+}
+
+static void ReleaseFrames(CaptureSession* c) {
+    for (int i = 0; i < CAPTURE_GPU_FRAMES; i++) {
+        if (c->targets[i]) SDL_DestroyTexture(c->targets[i]);
+        c->targets[i] = NULL;
+    }
+    for (int i = 0; i < CAPTURE_BUFFERS; i++) {
+        free(c->buffers[i].pixels);
+        c->buffers[i].pixels = NULL;
+    }
+}
+
+static bool AllocFrames(CaptureSession* c, int w, int h) {
+    c->w = w; c->h = h;
+    c->pitch = w * 4;
+    for (int i = 0; i < CAPTURE_GPU_FRAMES; i++) {
+        c->targets[i] = SDL_CreateTexture(c->renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+        if (!c->targets[i]) return false;
+    }
+    for (int i = 0; i < CAPTURE_BUFFERS; i++) {
+        c->buffers[i].pixels = malloc((size_t)c->pitch * (size_t)h);
+        if (!c->buffers[i].pixels) return false;
+    }
+    return true;
+}
+
+static void FreeCapture(CaptureSession* c) {
+    ReleaseFrames(c);
+    if (c->ready) SDL_DestroySemaphore(c->ready);
+    if (c->stream) fclose(c->stream);
+    free(c);
+}
+
+CaptureSession* StartCapture(SDL_Renderer* r, const char* path, int w, int h) {
+    int format = strchr(path, '%') ? CAPTURE_PNG : CAPTURE_RAW;
+    if (format == CAPTURE_PNG && !ValidTemplate(path)) {
+        SDL_SetError("capture path %s needs exactly one %%d or %%0Nd", path);
+        return NULL;
+    }
+    if (strlen(path) >= CAPTURE_PATH_MAX) {
+        SDL_SetError("capture path too long");
+        return NULL;
+    }
+
+    CaptureSession* c = calloc(1, sizeof(CaptureSession));
+    if (!c) return NULL;
+    c->renderer = r;
+    c->format = format;
+    SDL_strlcpy(c->path, path, sizeof(c->path));
+
+    bool ok = true;
+    if (c->format == CAPTURE_RAW) ok = (c->stream = fopen(path, "wb")) != NULL;
+    if (ok) ok = AllocFrames(c, w, h);
+    if (ok) ok = (c->ready = SDL_CreateSemaphore(0)) != NULL;
+    if (ok) ok = (c->thread = SDL_CreateThread(EncoderThread, "capture", c)) != NULL;
+    if (!ok) {
+        FreeCapture(c);
+        return NULL;
+    }
+    return c;
+}
+
+static void ReadBack(CaptureSession* c, long frame) {
+    CaptureBuffer* b = &c->buffers[c->head];
+    if (SDL_AtomicGet(&b->state) != CAPTURE_FREE) {
+        c->dropped++;
+        return;
+    }
+    SDL_SetRenderTarget(c->renderer, c->targets[frame % CAPTURE_GPU_FRAMES]);
+    if (SDL_RenderReadPixels(c->renderer, NULL, SDL_PIXELFORMAT_RGBA32, b->pixels, c->pitch) != 0) {
+        c->dropped++;
+        return;
+    }
+    b->frame = frame;
+    SDL_AtomicSet(&b->state, CAPTURE_FILLED);
+    c->head = (c->head + 1) % CAPTURE_BUFFERS;
+    c->captured++;
+    SDL_SemPost(c->ready);
+}
+
+void BeginCaptureFrame(CaptureSession* c) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    if (c->rendered - CAPTURE_LAG >= c->first) ReadBack(c, c->rendered - CAPTURE_LAG);
+    SDL_SetRenderTarget(c->renderer, c->targets[c->rendered % CAPTURE_GPU_FRAMES]);
+    c->framePerf = SDL_GetPerformanceCounter() - start;
+}
+
+void EndCaptureFrame(CaptureSession* c) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    SDL_SetRenderTarget(c->renderer, NULL);
+    SDL_SetRenderDrawColor(c->renderer, 0, 0, 0, 255);
+    SDL_RenderClear(c->renderer);
+    SDL_RenderCopy(c->renderer, c->targets[c->rendered % CAPTURE_GPU_FRAMES], NULL, NULL);
+    c->rendered++;
+    Uint64 spent = c->framePerf + SDL_GetPerformanceCounter() - start;
+    c->totalPerf += spent;
+    if (spent > c->worstPerf) c->worstPerf = spent;
+}
+
+static void FlushCapture(CaptureSession* c) {
+    for (long f = c->rendered - CAPTURE_LAG; f < c->rendered; f++) {
+        if (f < c->first) continue;
+        while (SDL_AtomicGet(&c->buffers[c->head].state) != CAPTURE_FREE) SDL_Delay(1);
+        ReadBack(c, f);
+    }
+    for (int i = 0; i < CAPTURE_BUFFERS; i++) {
+        while (SDL_AtomicGet(&c->buffers[i].state) != CAPTURE_FREE) SDL_Delay(1);
+    }
+    c->first = c->rendered;
+    SDL_SetRenderTarget(c->renderer, NULL);
+}
+
+bool ResizeCapture(CaptureSession* c, int w, int h) {
+    if (w == c->w && h == c->h) return true;
+    if (c->format == CAPTURE_RAW) {
+        SDL_SetError("raw stream %s is fixed at %dx%d, view is now %dx%d", c->path, c->w, c->h, w, h);
+        return false;
+    }
+    FlushCapture(c);
+    ReleaseFrames(c);
+    return AllocFrames(c, w, h);
+}
+
+void StopCapture(CaptureSession* c) {
+    if (!c) return;
+    FlushCapture(c);
+
+    SDL_AtomicSet(&c->quit, 1);
+    SDL_SemPost(c->ready);
+    SDL_WaitThread(c->thread, NULL);
+
+    printf("capture: %ld frames captured, %ld dropped, %s%s\n", c->captured, c->dropped, c->path,
+        SDL_AtomicGet(&c->failed) ? " (encoder write failed)" : "");
+    double freq = (double)SDL_GetPerformanceFrequency();
+    double mean = c->rendered > 0 ? (double)c->totalPerf / (double)c->rendered / freq * 1000.0 : 0.0;
+    printf("capture: main thread %.3f ms/frame mean, %.3f ms worst\n", mean, (double)c->worstPerf / freq * 1000.0);
+    if (c->format == CAPTURE_RAW) {
+        printf("capture: ffmpeg -f rawvideo -pixel_format rgba -video_size %dx%d -i %s out.mp4\n", c->w, c->h, c->path);
+    }
+    FreeCapture(c);
+}
@@ -0,0 +1,57 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#define CAPTURE_GPU_FRAMES 3
+#define CAPTURE_LAG 2
+#define CAPTURE_BUFFERS 8
+#define CAPTURE_PATH_MAX 256
+
+enum {
+    CAPTURE_FREE,
+    CAPTURE_FILLED
+};
+
+enum {
+    CAPTURE_RAW,
+    CAPTURE_PNG
+};
+
+typedef struct {
+    SDL_atomic_t state;
+    long frame;
+    Uint8* pixels;
+} CaptureBuffer;
+
+typedef struct {
+    SDL_Renderer* renderer;
+    int w, h, pitch;
+    int format;
+    char path[CAPTURE_PATH_MAX];
+    FILE* stream;
+
+    SDL_Texture* targets[CAPTURE_GPU_FRAMES];
+    long rendered;
+    long first;
+
+    CaptureBuffer buffers[CAPTURE_BUFFERS];
+    int head, tail;
+    SDL_Thread* thread;
+    SDL_sem* ready;
+    SDL_atomic_t quit;
+    SDL_atomic_t failed;
+
+    long captured, dropped;
+    Uint64 framePerf, totalPerf, worstPerf;
+} CaptureSession;
+
+CaptureSession* StartCapture(SDL_Renderer* r, const char* path, int w, int h);
+void BeginCaptureFrame(CaptureSession* c);
+void EndCaptureFrame(CaptureSession* c);
+bool ResizeCapture(CaptureSession* c, int w, int h);
+void StopCapture(CaptureSession* c);
+
+#endif
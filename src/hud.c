@@ -0,0 +1,178 @@
+#include "hud.h"
+#include "sim.h"
+#include <math.h>
+#include <string.h>
+
+bool IsPointInRect(float x, float y, SDL_Rect r) {
+    return (x >= r.x && x <= r.x + r.w && y >= r.y && y <= r.y + r.h);
+}
+
+void TouchToGameCoords(int winW, int winH, int gameW, int gameH, float normX, float normY, float* outX, float* outY) {
+    float scaleX = (float)winW / gameW;
+    float scaleY = (float)winH / gameH;
+    float scale = (scaleX < scaleY) ? scaleX : scaleY;
+
+    float viewW = gameW * scale;
+    float viewH = gameH * scale;
+
+    float offX = (winW - viewW) / 2.0f;
+    float offY = (winH - viewH) / 2.0f;
+
+    float touchWinX = normX * winW;
+    float touchWinY = normY * winH;
+
+    *outX = (touchWinX - offX) / scale;
+    *outY = (touchWinY - offY) / scale;
+}
+
+bool LayoutHud(HudLayer* hud, SDL_Renderer* r, DPad* pad, Button** btns, int gameW, int gameH) {
+    Button* jump = btns[0];
+    Button* attack = btns[1];
+    Button* dash = btns[2];
+
+    pad->area = (SDL_Rect){ UI_MARGIN, gameH - DPAD_SIZE - UI_MARGIN, DPAD_SIZE, DPAD_SIZE };
+
+    int startX = gameW - UI_MARGIN - BTN_SIZE;
+    int startY = gameH - UI_MARGIN - BTN_SIZE;
+    jump->area = (SDL_Rect){ startX, startY, BTN_SIZE, BTN_SIZE };
+    attack->area = (SDL_Rect){ startX - BTN_SIZE - 10, startY, BTN_SIZE, BTN_SIZE };
+    int midX = attack->area.x + (jump->area.x + jump->area.w - attack->area.x)/2 - BTN_SIZE/2;
+    dash->area = (SDL_Rect){ midX, startY - BTN_SIZE - 10, BTN_SIZE, BTN_SIZE };
+
+    hud->screen[HUD_PAD] = pad->area;
+    hud->screen[HUD_BUTTONS] = (SDL_Rect){ attack->area.x, dash->area.y,
+        jump->area.x + jump->area.w - attack->area.x, jump->area.y + jump->area.h - dash->area.y };
+    hud->screen[HUD_TEXT] = (SDL_Rect){ gameW - HUD_TEXT_W, 0, HUD_TEXT_W, HUD_TEXT_H };
+
+    int texW = 0, texH = 0;
+    for (int i = 0; i < HUD_REGIONS; i++) {
+        hud->local[i] = (SDL_Rect){ texW, 0, hud->screen[i].w, hud->screen[i].h };
+        texW += hud->screen[i].w;
+        if (hud->screen[i].h > texH) texH = hud->screen[i].h;
+    }
+
+    int w = 0, h = 0;
+    if (hud->tex) SDL_QueryTexture(hud->tex, NULL, NULL, &w, &h);
+    if (w != texW || h != texH) {
+        if (hud->tex) SDL_DestroyTexture(hud->tex);
+        hud->tex = SDL_CreateTexture(r, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, texW, texH);
+        if (!hud->tex) return false;
+        SDL_SetTextureBlendMode(hud->tex, SDL_BLENDMODE_BLEND);
+    }
+    InvalidateHud(hud);
+    return true;
+}
+
+void AnimateControls(DPad* pad, Button** btns, float dt) {
+    for (int i = 0; i < 3; i++) {
+        float target = btns[i]->active ? 0.85f : 1.0f;
+        btns[i]->currentScale = Lerp(btns[i]->currentScale, target, 25.0f * dt);
+    }
+    float padTarget = pad->active ? 0.95f : 1.0f;
+    pad->scale = Lerp(pad->scale, padTarget, 25.0f * dt);
+}
+
+bool HudSettled(const DPad* pad, Button** btns) {
+    if (pad->active || pad->left || pad->right || pad->up || pad->down) return false;
+    if (fabsf(pad->scale - 1.0f) > 0.002f) return false;
+    for (int i = 0; i < 3; i++) {
+        if (btns[i]->active || fabsf(btns[i]->currentScale - 1.0f) > 0.002f) return false;
+    }
+    return true;
+}
+
+void InvalidateHud(HudLayer* hud) {
+    for (int i = 0; i < HUD_REGIONS; i++) hud->dirty[i] = true;
+}
+
+static void BeginRegion(HudLayer* hud, SDL_Renderer* r, int region) {
+    SDL_SetRenderTarget(r, hud->tex);
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(r, 0, 0, 0, 0);
+    SDL_RenderFillRect(r, &hud->local[region]);
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+    hud->dirty[region] = false;
+    hud->redraws++;
+}
+
+static SDL_FRect ToLocal(const HudLayer* hud, int region, int x, int y, int w, int h) {
+    SDL_FRect dst = { x - hud->screen[region].x + hud->local[region].x, y - hud->screen[region].y + hud->local[region].y, w, h };
+    return dst;
+}
+
+void UpdateHud(HudLayer* hud, SDL_Renderer* r, SpriteBatch* batch, const TextureAtlas* sprites, GlyphAtlas* text,
+               const DPad* pad, Button** btns, const char* timer, const char* warning) {
+    SDL_Color cOpaque = {255, 255, 255, 255};
+    if (!hud->tex) return;
+
+    int pw = (int)(pad->area.w * pad->scale);
+    int ph = (int)(pad->area.h * pad->scale);
+    int padBits = pad->left | (pad->right << 1) | (pad->up << 2) | (pad->down << 3);
+    if (padBits != hud->padKey[0] || pw != hud->padKey[1] || ph != hud->padKey[2]) {
+        hud->padKey[0] = padBits; hud->padKey[1] = pw; hud->padKey[2] = ph;
+        hud->dirty[HUD_PAD] = true;
+    }
+    for (int i = 0; i < 3; i++) {
+        int w = (int)(btns[i]->area.w * btns[i]->currentScale);
+        if (w != hud->buttonKey[i]) { hud->buttonKey[i] = w; hud->dirty[HUD_BUTTONS] = true; }
+    }
+    if (strncmp(timer, hud->text[0], HUD_TEXT_MAX) || strncmp(warning, hud->text[1], HUD_TEXT_MAX)) {
+        SDL_strlcpy(hud->text[0], timer, HUD_TEXT_MAX);
+        SDL_strlcpy(hud->text[1], warning, HUD_TEXT_MAX);
+        hud->dirty[HUD_TEXT] = true;
+    }
+    if (!hud->dirty[HUD_PAD] && !hud->dirty[HUD_BUTTONS] && !hud->dirty[HUD_TEXT]) return;
+
+    if (hud->dirty[HUD_PAD]) {
+        BeginRegion(hud, r, HUD_PAD);
+        BatchBegin(batch, sprites->tex);
+        SDL_FRect dstPad = ToLocal(hud, HUD_PAD, pad->area.x + (pad->area.w - pw)/2, pad->area.y + (pad->area.h - ph)/2, pw, ph);
+        BatchSprite(batch, r, sprites->rects[pad->sprite], dstPad, SDL_FLIP_NONE, cOpaque);
+        if (pad->left)  BatchSprite(batch, r, sprites->rects[pad->sprite + 1], dstPad, SDL_FLIP_NONE, cOpaque);
+        if (pad->right) BatchSprite(batch, r, sprites->rects[pad->sprite + 2], dstPad, SDL_FLIP_NONE, cOpaque);
+        if (pad->up)    BatchSprite(batch, r, sprites->rects[pad->sprite + 3], dstPad, SDL_FLIP_NONE, cOpaque);
+        if (pad->down)  BatchSprite(batch, r, sprites->rects[pad->sprite + 4], dstPad, SDL_FLIP_NONE, cOpaque);
+        BatchFlush(batch, r);
+    }
+
+    if (hud->dirty[HUD_BUTTONS]) {
+        BeginRegion(hud, r, HUD_BUTTONS);
+        BatchBegin(batch, sprites->tex);
+        for (int i = 0; i < 3; i++) {
+            SDL_Rect a = btns[i]->area;
+            int w = (int)(a.w * btns[i]->currentScale);
+            int h = (int)(a.h * btns[i]->currentScale);
+            SDL_FRect dstBtn = ToLocal(hud, HUD_BUTTONS, a.x + (a.w - w) / 2, a.y + (a.h - h) / 2, w, h);
+            BatchSprite(batch, r, sprites->rects[btns[i]->sprite], dstBtn, SDL_FLIP_NONE, cOpaque);
+        }
+        BatchFlush(batch, r);
+    }
+
+    if (hud->dirty[HUD_TEXT]) {
+        BeginRegion(hud, r, HUD_TEXT);
+        SDL_Rect t = hud->local[HUD_TEXT];
+        SDL_Color cWhite = {255, 255, 255, 255};
+        SDL_Color cRed = {255, 50, 50, 255};
+        RenderText(r, text, hud->text[0], t.x + t.w - 10, t.y + 10, cWhite, true);
+        if (hud->text[1][0]) RenderText(r, text, hud->text[1], t.x + t.w - 10, t.y + 40, cRed, true);
+    }
+
+    SDL_SetRenderTarget(r, NULL);
+}
+
+void DrawHud(HudLayer* hud, SDL_Renderer* r, SpriteBatch* batch) {
+    if (!hud->tex) return;
+    SDL_Color cOpaque = {255, 255, 255, 255};
+    BatchBegin(batch, hud->tex);
+    for (int i = 0; i < HUD_REGIONS; i++) {
+        SDL_Rect s = hud->screen[i];
+        SDL_FRect dst = { s.x, s.y, s.w, s.h };
+        BatchSprite(batch, r, hud->local[i], dst, SDL_FLIP_NONE, cOpaque);
+    }
+    BatchFlush(batch, r);
+}
+
+void DestroyHud(HudLayer* hud) {
+    if (hud->tex) SDL_DestroyTexture(hud->tex);
+    hud->tex = NULL;
+}
@@ -0,0 +1,70 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+#include "atlas.h"
+#include "batch.h"
+#include "text.h"
+
+#define BTN_SIZE 90
+#define DPAD_SIZE 165  
+
+#define UI_MARGIN 20
+
+#define HUD_TEXT_W 200
+#define HUD_TEXT_H 64
+#define HUD_TEXT_MAX 32
+
+typedef struct {
+    SDL_Rect area;
+    bool left, right, up, down;
+    bool active; 
+    SDL_FingerID fingerId; 
+    float scale; 
+    int sprite;
+} DPad;
+
+typedef struct {
+    SDL_FingerID fingerId;
+    bool active;
+    SDL_Rect area;
+    bool justPressed;
+    bool justReleased;
+    int sprite;
+    float currentScale; 
+    Uint64 pressPerf;
+} Button;
+
+enum {
+    HUD_PAD,
+    HUD_BUTTONS,
+    HUD_TEXT,
+    HUD_REGIONS
+};
+
+typedef struct {
+    SDL_Texture* tex;
+    SDL_Rect screen[HUD_REGIONS];
+    SDL_Rect local[HUD_REGIONS];
+    bool dirty[HUD_REGIONS];
+    int padKey[3];
+    int buttonKey[3];
+    char text[2][HUD_TEXT_MAX];
+    int redraws;
+} HudLayer;
+
+bool IsPointInRect(float x, float y, SDL_Rect r);
+void TouchToGameCoords(int winW, int winH, int gameW, int gameH, float normX, float normY, float* outX, float* outY);
+
+bool LayoutHud(HudLayer* hud, SDL_Renderer* r, DPad* pad, Button** btns, int gameW, int gameH);
+void AnimateControls(DPad* pad, Button** btns, float dt);
+bool HudSettled(const DPad* pad, Button** btns);
+void UpdateHud(HudLayer* hud, SDL_Renderer* r, SpriteBatch* batch, const TextureAtlas* sprites, GlyphAtlas* text,
+               const DPad* pad, Button** btns, const char* timer, const char* warning);
+void DrawHud(HudLayer* hud, SDL_Renderer* r, SpriteBatch* batch);
+void InvalidateHud(HudLayer* hud);
+void DestroyHud(HudLayer* hud);
+
+#endif
@@ -0,0 +1,84 @@
+#include "jobs.h"
+#include <stdlib.h>
+
+static void RunSlices(JobSystem* jobs, int self) {
+    int n = jobs->numThreads;
+    for (int k = 0; k < n; k++) {
+        JobSlice* s = &jobs->slices[(self + k) % n];
+        for (;;) {
+            int begin = SDL_AtomicAdd(&s->next, jobs->grain);
+            if (begin >= s->end) break;
+            int end = begin + jobs->grain;
+            if (end > s->end) end = s->end;
+            jobs->func(jobs->ctx, begin, end);
+        }
+    }
+}
+
+static int WorkerThread(void* data) {
+    JobWorker* w = data;
+    JobSystem* jobs = w->jobs;
+    for (;;) {
+        SDL_SemWait(jobs->start);
+        if (SDL_AtomicGet(&jobs->quit)) break;
+        RunSlices(jobs, w->index);
+        SDL_SemPost(jobs->done);
+    }
+    return 0;
+}
+
+JobSystem* CreateJobSystem(int numThreads) {
+    if (numThreads <= 0) numThreads = SDL_GetCPUCount();
+    if (numThreads > JOBS_MAX_THREADS) numThreads = JOBS_MAX_THREADS;
+    if (numThreads < 1) numThreads = 1;
+
+    JobSystem* jobs = calloc(1, sizeof(JobSystem));
+    if (!jobs) return NULL;
+    jobs->numThreads = 1;
+    jobs->start = SDL_CreateSemaphore(0);
+    jobs->done = SDL_CreateSemaphore(0);
+    if (!jobs->start || !jobs->done) {
+        DestroyJobSystem(jobs);
+        return NULL;
+    }
+
+    for (int i = 1; i < numThreads; i++) {
+        jobs->workers[i] = (JobWorker){ jobs, i };
+        jobs->threads[i] = SDL_CreateThread(WorkerThread, "job", &jobs->workers[i]);
+        if (!jobs->threads[i]) break;
+        jobs->numThreads++;
+    }
+    return jobs;
+}
+
+void DestroyJobSystem(JobSystem* jobs) {
+    if (!jobs) return;
+    SDL_AtomicSet(&jobs->quit, 1);
+    for (int i = 1; i < jobs->numThreads; i++) SDL_SemPost(jobs->start);
+    for (int i = 1; i < jobs->numThreads; i++) SDL_WaitThread(jobs->threads[i], NULL);
+    if (jobs->start) SDL_DestroySemaphore(jobs->start);
+    if (jobs->done) SDL_DestroySemaphore(jobs->done);
+    free(jobs);
+}
+
+void ParallelFor(JobSystem* jobs, int count, int grain, JobRangeFunc func, void* ctx) {
+    if (count <= 0) return;
+    if (grain < 1) grain = 1;
+    if (!jobs || jobs->numThreads == 1 || count <= grain) {
+        func(ctx, 0, count);
+        return;
+    }
+
+    int n = jobs->numThreads;
+    jobs->func = func;
+    jobs->ctx = ctx;
+    jobs->grain = grain;
+    for (int i = 0; i < n; i++) {
+        SDL_AtomicSet(&jobs->slices[i].next, (int)((long long)count * i / n));
+        jobs->slices[i].end = (int)((long long)count * (i + 1) / n);
+    }
+
+    for (int i = 1; i < n; i++) SDL_SemPost(jobs->start);
+    RunSlices(jobs, 0);
+    for (int i = 1; i < n; i++) SDL_SemWait(jobs->done);
+}
@@ -0,0 +1,41 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <SDL2/SDL.h>
+
+#define JOBS_MAX_THREADS 32
+
+typedef void (*JobRangeFunc)(void* ctx, int begin, int end);
+
+typedef struct {
+    SDL_atomic_t next;
+    int end;
+    char pad[56];
+} JobSlice;
+
+typedef struct JobSystem JobSystem;
+
+typedef struct {
+    JobSystem* jobs;
+    int index;
+} JobWorker;
+
+struct JobSystem {
+    int numThreads;
+    SDL_Thread* threads[JOBS_MAX_THREADS];
+    JobWorker workers[JOBS_MAX_THREADS];
+    SDL_sem* start;
+    SDL_sem* done;
+    SDL_atomic_t quit;
+
+    JobRangeFunc func;
+    void* ctx;
+    int grain;
+    JobSlice slices[JOBS_MAX_THREADS];
+};
+
+JobSystem* CreateJobSystem(int numThreads);
+void DestroyJobSystem(JobSystem* jobs);
+void ParallelFor(JobSystem* jobs, int count, int grain, JobRangeFunc func, void* ctx);
+
+#endif
@@ -0,0 +1,52 @@
+#include "latency.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static const char* probeNames[PROBE_COUNT] = { "jump", "attack", "dash" };
+
+Uint64 EventPerf(Uint32 timestamp) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint32 age = SDL_GetTicks() - timestamp;
+    if (age > 1000) return now;
+    return now - (Uint64)age * SDL_GetPerformanceFrequency() / 1000;
+}
+
+void ProbeInput(LatencyProbe* p, int kind, Uint64 eventPerf, uint32_t shown) {
+    if (p->pending[kind]) return;
+    p->pending[kind] = true;
+    p->eventPerf[kind] = eventPerf;
+    p->baseline[kind] = shown;
+}
+
+void ProbePresented(LatencyProbe* p, const uint32_t* shown, Uint64 presentPerf) {
+    double freq = (double)SDL_GetPerformanceFrequency();
+    for (int k = 0; k < PROBE_COUNT; k++) {
+        if (!p->pending[k]) continue;
+        double ms = (double)(presentPerf - p->eventPerf[k]) * 1000.0 / freq;
+        if (shown[k] != p->baseline[k]) {
+            p->samples[k][p->count[k] % LATENCY_SAMPLES] = (float)ms;
+            p->count[k]++;
+            p->pending[k] = false;
+            SDL_Log("latency: %s %.1f ms input-to-present", probeNames[k], ms);
+        } else if (ms > LATENCY_TIMEOUT * 1000.0) {
+            p->pending[k] = false;
+        }
+    }
+}
+
+static int CompareFloat(const void* a, const void* b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+void ProbeReport(const LatencyProbe* p) {
+    for (int k = 0; k < PROBE_COUNT; k++) {
+        int n = p->count[k] < LATENCY_SAMPLES ? p->count[k] : LATENCY_SAMPLES;
+        if (n == 0) continue;
+        float sorted[LATENCY_SAMPLES];
+        for (int i = 0; i < n; i++) sorted[i] = p->samples[k][i];
+        qsort(sorted, (size_t)n, sizeof(float), CompareFloat);
+        printf("latency: %-6s n=%d min %.1f p50 %.1f p95 %.1f max %.1f ms\n", probeNames[k], p->count[k],
+            sorted[0], sorted[n / 2], sorted[(n * 95) / 100 < n ? (n * 95) / 100 : n - 1], sorted[n - 1]);
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define LATENCY_SAMPLES 256
+#define LATENCY_TIMEOUT 0.5
+
+enum {
+    PROBE_JUMP,
+    PROBE_ATTACK,
+    PROBE_DASH,
+    PROBE_COUNT
+};
+
+typedef struct {
+    bool pending[PROBE_COUNT];
+    Uint64 eventPerf[PROBE_COUNT];
+    uint32_t baseline[PROBE_COUNT];
+    int count[PROBE_COUNT];
+    float samples[PROBE_COUNT][LATENCY_SAMPLES];
+} LatencyProbe;
+
+Uint64 EventPerf(Uint32 timestamp);
+void ProbeInput(LatencyProbe* p, int kind, Uint64 eventPerf, uint32_t shown);
+void ProbePresented(LatencyProbe* p, const uint32_t* shown, Uint64 presentPerf);
+void ProbeReport(const LatencyProbe* p);
+
+#endif
@@ -0,0 +1,184 @@
+#include "level.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+bool checkCol(RectF p, RectF w) {
+    return (p.x < w.x + w.w && p.x + p.w > w.x &&
+            p.y < w.y + w.h && p.y + p.h > w.y);
+}
+
+static int CellX(const Level* level, float x) {
+    int c = (int)floorf((x - level->originX) / level->cellSize);
+    if (c < 0) c = 0;
+    if (c >= level->gridW) c = level->gridW - 1;
+    return c;
+}
+
+static int CellY(const Level* level, float y) {
+    int c = (int)floorf((y - level->originY) / level->cellSize);
+    if (c < 0) c = 0;
+    if (c >= level->gridH) c = level->gridH - 1;
+    return c;
+}
+
+static bool BuildGrid(Level* level) {
+    float minX = 0, minY = 0, maxX = 0, maxY = 0;
+    for (int i = 0; i < level->numRects; i++) {
+        const RectF* r = &level->rects[i];
+        if (i == 0 || r->x < minX) minX = r->x;
+        if (i == 0 || r->y < minY) minY = r->y;
+        if (i == 0 || r->x + r->w > maxX) maxX = r->x + r->w;
+        if (i == 0 || r->y + r->h > maxY) maxY = r->y + r->h;
+    }
+
+    float cs = LEVEL_CELL_SIZE;
+    while ((double)((maxX - minX) / cs + 1) * (double)((maxY - minY) / cs + 1) > LEVEL_MAX_CELLS) cs *= 2.0f;
+
+    level->originX = minX;
+    level->originY = minY;
+    level->cellSize = cs;
+    level->gridW = (int)((maxX - minX) / cs) + 1;
+    level->gridH = (int)((maxY - minY) / cs) + 1;
+
+    int numCells = level->gridW * level->gridH;
+    level->cellStart = calloc((size_t)numCells + 1, sizeof(int));
+    if (!level->cellStart) return false;
+
+    for (int i = 0; i < level->numRects; i++) {
+        const RectF* r = &level->rects[i];
+        int cx0 = CellX(level, r->x), cx1 = CellX(level, r->x + r->w);
+        int cy0 = CellY(level, r->y), cy1 = CellY(level, r->y + r->h);
+        for (int cy = cy0; cy <= cy1; cy++)
+            for (int cx = cx0; cx <= cx1; cx++) level->cellStart[cy * level->gridW + cx + 1]++;
+    }
+    for (int c = 0; c < numCells; c++) level->cellStart[c + 1] += level->cellStart[c];
+
+    level->cellItems = malloc(sizeof(int) * (size_t)(level->cellStart[numCells] > 0 ? level->cellStart[numCells] : 1));
+    int* cursor = malloc(sizeof(int) * (size_t)numCells);
+    if (!level->cellItems || !cursor) { free(cursor); return false; }
+    memcpy(cursor, level->cellStart, sizeof(int) * (size_t)numCells);
+
+    for (int i = 0; i < level->numRects; i++) {
+        const RectF* r = &level->rects[i];
+        int cx0 = CellX(level, r->x), cx1 = CellX(level, r->x + r->w);
+        int cy0 = CellY(level, r->y), cy1 = CellY(level, r->y + r->h);
+        for (int cy = cy0; cy <= cy1; cy++)
+            for (int cx = cx0; cx <= cx1; cx++) level->cellItems[cursor[cy * level->gridW + cx]++] = i;
+    }
+    free(cursor);
+    return true;
+}
+
+static Level* FinishLevel(MappedFile file) {
+    const LevelHeader* hdr = file.data;
+    size_t size = file.size;
+    if (size < sizeof(LevelHeader) || hdr->magic != LEVEL_MAGIC || hdr->version != LEVEL_VERSION ||
+        hdr->numRects > (size - sizeof(LevelHeader)) / sizeof(RectF)) {
+        fprintf(stderr, "level: bad header\n");
+        return NULL;
+    }
+
+    const RectF* rects = (const RectF*)((const char*)file.data + sizeof(LevelHeader));
+    float minX = 0, minY = 0, maxX = 0, maxY = 0;
+    for (uint32_t i = 0; i < hdr->numRects; i++) {
+        const RectF* r = &rects[i];
+        if (!isfinite(r->x) || !isfinite(r->y) || !isfinite(r->w) || !isfinite(r->h) || r->w < 0 || r->h < 0) {
+            fprintf(stderr, "level: bad rect\n");
+            return NULL;
+        }
+        minX = fminf(minX, r->x); maxX = fmaxf(maxX, r->x + r->w);
+        minY = fminf(minY, r->y); maxY = fmaxf(maxY, r->y + r->h);
+    }
+    if (!isfinite(maxX - minX) || !isfinite(maxY - minY)) {
+        fprintf(stderr, "level: bad rect\n");
+        return NULL;
+    }
+
+    Level* level = calloc(1, sizeof(Level));
+    if (!level) return NULL;
+    level->rects = rects;
+    level->numRects = (int)hdr->numRects;
+    level->spawnX = hdr->spawnX;
+    level->spawnY = hdr->spawnY;
+    level->file = file;
+
+    if (!BuildGrid(level)) {
+        level->file = (MappedFile){ NULL, 0, false };
+        FreeLevel(level);
+        return NULL;
+    }
+    return level;
+}
+
+Level* LoadLevel(const char* path) {
+    MappedFile file;
+    if (!MapFile(path, &file)) return NULL;
+    Level* level = FinishLevel(file);
+    if (!level) UnmapFile(&file);
+    return level;
+}
+
+Level* CreateLevel(const RectF* rects, int numRects, float spawnX, float spawnY) {
+    size_t size = sizeof(LevelHeader) + sizeof(RectF) * (size_t)numRects;
+    void* data = malloc(size);
+    if (!data) return NULL;
+
+    LevelHeader hdr = { LEVEL_MAGIC, LEVEL_VERSION, (uint32_t)numRects, spawnX, spawnY, {0, 0, 0} };
+    memcpy(data, &hdr, sizeof(hdr));
+    if (numRects > 0) memcpy((char*)data + sizeof(hdr), rects, sizeof(RectF) * (size_t)numRects);
+
+    MappedFile file = { data, size, false };
+    Level* level = FinishLevel(file);
+    if (!level) free(data);
+    return level;
+}
+
+Level* CreateDefaultLevel(void) {
+    RectF platform = { -50, 280, 2000, 80 }; 
+    return CreateLevel(&platform, 1, 50, 200);
+}
+
+bool SaveLevel(const char* path, const RectF* rects, int numRects, float spawnX, float spawnY) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    LevelHeader hdr = { LEVEL_MAGIC, LEVEL_VERSION, (uint32_t)numRects, spawnX, spawnY, {0, 0, 0} };
+    bool ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1 &&
+              (numRects == 0 || fwrite(rects, sizeof(RectF), (size_t)numRects, f) == (size_t)numRects);
+    fclose(f);
+    return ok;
+}
+
+void FreeLevel(Level* level) {
+    if (!level) return;
+    UnmapFile(&level->file);
+    free(level->cellStart);
+    free(level->cellItems);
+    free(level);
+}
+
+int LevelQuery(const Level* level, RectF area, int* out, int maxOut) {
+    int count = 0;
+    int qx0 = CellX(level, area.x), qx1 = CellX(level, area.x + area.w);
+    int qy0 = CellY(level, area.y), qy1 = CellY(level, area.y + area.h);
+
+    for (int cy = qy0; cy <= qy1; cy++) {
+        for (int cx = qx0; cx <= qx1; cx++) {
+            int cell = cy * level->gridW + cx;
+            for (int k = level->cellStart[cell]; k < level->cellStart[cell + 1]; k++) {
+                int idx = level->cellItems[k];
+                const RectF* r = &level->rects[idx];
+                if (!checkCol(area, *r)) continue;
+
+                int ownerX = CellX(level, r->x); if (ownerX < qx0) ownerX = qx0;
+                int ownerY = CellY(level, r->y); if (ownerY < qy0) ownerY = qy0;
+                if (ownerX != cx || ownerY != cy) continue;
+
+                if (count == maxOut) return count;
+                out[count++] = idx;
+            }
+        }
+    }
+    return count;
+}
@@ -0,0 +1,49 @@
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mapfile.h"
+
+#define LEVEL_MAGIC 0x314C564Cu
+#define LEVEL_VERSION 1
+#define LEVEL_CELL_SIZE 128.0f
+#define LEVEL_MAX_CELLS (1 << 20)
+
+typedef struct { float x, y, w, h; } RectF;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t numRects;
+    float spawnX, spawnY;
+    uint32_t reserved[3];
+} LevelHeader;
+
+typedef struct {
+    const RectF* rects;
+    int numRects;
+    float spawnX, spawnY;
+
+    float originX, originY;
+    float cellSize;
+    int gridW, gridH;
+    int* cellStart;
+    int* cellItems;
+
+    MappedFile file;
+} Level;
+
+Level* LoadLevel(const char* path);
+Level* CreateLevel(const RectF* rects, int numRects, float spawnX, float spawnY);
+Level* CreateDefaultLevel(void);
+bool SaveLevel(const char* path, const RectF* rects, int numRects, float spawnX, float spawnY);
+void FreeLevel(Level* level);
+
+bool checkCol(RectF p, RectF w);
+
+int LevelQuery(const Level* level, RectF area, int* out, int maxOut);
+
+#endif
@@ -3,234 +3,455 @@
 #include <SDL2/SDL_ttf.h>
 #include <SDL2/SDL_mixer.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
 #include <math.h>
 
+#include "assets.h"
+#include "atlas.h"
+#include "audio.h"
+#include "batch.h"
+#include "capture.h"
+#include "hud.h"
+#include "jobs.h"
+#include "latency.h"
+#include "particles.h"
+#include "power.h"
+#include "profiler.h"
+#include "replay.h"
+#include "resolution.h"
+#include "rollback.h"
+#include "runner.h"
+#include "sim.h"
+#include "stream.h"
+#include "text.h"
+#include "tuning.h"
+#include "world.h"
+
 #define FIXED_HEIGHT 360
 
-#define GRAVITY 3200.0f
-#define JUMP_FORCE -960.0f
-#define MAX_SPEED 300.0f
-#define ACCEL_GROUND 2500.0f
-#define FRICTION_GROUND 1800.0f
-#define ACCEL_AIR 1500.0f
-#define FRICTION_AIR 500.0f
-
-#define DASH_SPEED 1000.0f
-#define DASH_DURATION 0.15f
-#define DASH_COOLDOWN 0.6f
-#define IDLE_DEATH_TIME 1.5f
-
-#define SPRITE_SIZE 20
-#define DRAW_SIZE 80  
-#define SPRITE_OFFSET_Y 10
-#define ARMED_OFFSET_X 100
-
-#define BTN_SIZE 90
-#define DPAD_SIZE 165  
-
-#define UI_MARGIN 20
-
-typedef struct { float x, y, w, h; } RectF;
-
-typedef struct {
-    float x, y;
-    int frameX, frameY;
-    bool facingRight;
-    float alpha; 
-} Ghost;
-
-typedef struct {
-    float x, y;
-    float startX, startY;
-    float vx, vy;
-    bool facingRight;
-
-    float animTimer;
-    int currentFrame;
-    int state; 
-
-    int lastState;
-
-    bool onGround;
-    float coyoteTimer;
-    float jumpBufferTimer;
-
-    float dashTimer;
-    float dashCooldownTimer;
-    bool isDashing;
-    bool isAttacking;
-    float idleDeathTimer;
-
-    float scaleX, scaleY;
-} Player;
-
-typedef struct {
-    SDL_Rect area;
-    bool left, right, up, down;
-    bool active; 
-    SDL_FingerID fingerId; 
-    float scale; 
-} DPad;
-
-typedef struct {
-    SDL_FingerID fingerId;
-    bool active;
-    SDL_Rect area;
-    bool justPressed;
-    bool justReleased;
-    SDL_Texture* tex;
-    float currentScale; 
-} Button;
+#define SIM_HZ 120
+#define MAX_FRAME_TIME 0.25
+#define MAX_TICKS_PER_FRAME 8
+
 
 SDL_Renderer* renderer = NULL;
 SDL_Window* window = NULL;
 
-SDL_Texture* texKnight = NULL;
-SDL_Texture* texPadBlank = NULL;
-SDL_Texture* texPadLeft = NULL;
-SDL_Texture* texPadRight = NULL;
-SDL_Texture* texPadUp = NULL;
-SDL_Texture* texPadDown = NULL;
-
+enum {
+    SPR_KNIGHT,
+    SPR_BTN_A, SPR_BTN_B, SPR_BTN_Y,
+    SPR_PAD_BLANK, SPR_PAD_LEFT, SPR_PAD_RIGHT, SPR_PAD_UP, SPR_PAD_DOWN,
+    SPR_COUNT
+};
+
+const AtlasSource spriteSources[SPR_COUNT] = {
+    { "knight.png", true },
+    { "a.png", false }, { "b.png", false }, { "y.png", false },
+    { "blank.png", false }, { "left.png", false }, { "right.png", false }, { "up.png", false }, { "down.png", false },
+};
+
+TextureAtlas* sprites = NULL;
+SpriteBatch* batch = NULL;
+ParticlePool particles;
+World world;
+JobSystem* jobs = NULL;
+
+const AssetManifest assetManifest = {
+    "assets.pak", spriteSources, SPR_COUNT, "PixelAE-Bold.ttf", 24, "japanese_8bit.mp3"
+};
+
+AssetLoader* assets = NULL;
 TTF_Font* fontBold = NULL;
+GlyphAtlas* textAtlas = NULL;
 Mix_Music* bgMusic = NULL;
-
-#define MAX_GHOSTS 20
-Ghost ghosts[MAX_GHOSTS];
-int ghostHead = 0;
+SfxMixer* sfx = NULL;
+
+SimRunner runner;
+LatencyProbe probe;
+RenderSnapshot frameSnap;
+RollbackSession rollback;
+LoopbackTransport transport;
+HudLayer hud;
+LowResTarget lowRes;
+ResolutionController resolution;
+PowerMode power;
+ChunkStreamer* streamer = NULL;
 
 int gameW = 640;
 int gameH = 360;
-float globalTimer = 0.0f;
 
-float Lerp(float a, float b, float t) {
-    return a + (b - a) * t;
+bool ShowLoadingScreen(Uint64 launchPerf) {
+    bool haveSprites = false, haveFont = false, firstFrame = true;
+    SDL_Event event;
+
+    while (!haveSprites || !haveFont) {
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_QUIT) return false;
+        }
+
+        if (!haveSprites && TakeAsset(assets, ASSET_SPRITES)) {
+            sprites = CreateTextureAtlas(renderer, assets->spriteSheet, assets->spriteRects, SPR_COUNT, assets->spriteWhite);
+            haveSprites = true;
+        }
+        if (!haveFont && TakeAsset(assets, ASSET_FONT)) {
+            fontBold = assets->font;
+            textAtlas = assets->glyphs;
+            if (textAtlas && !UploadGlyphAtlas(textAtlas, renderer)) {
+                DestroyGlyphAtlas(textAtlas);
+                textAtlas = NULL;
+            }
+            haveFont = true;
+        }
+
+        int w, h;
+        SDL_GetRendererOutputSize(renderer, &w, &h);
+        SDL_SetRenderDrawColor(renderer, 20, 20, 30, 255);
+        SDL_RenderClear(renderer);
+        SDL_SetRenderDrawColor(renderer, 100, 100, 120, 255);
+        int done = ASSET_COUNT - AssetsPending(assets);
+        SDL_Rect bar = { w / 4, h / 2 - 4, (w / 2) * done / ASSET_COUNT, 8 };
+        SDL_RenderFillRect(renderer, &bar);
+        SDL_RenderPresent(renderer);
+
+        if (firstFrame) {
+            double ms = (double)(SDL_GetPerformanceCounter() - launchPerf) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+            SDL_Log("startup: first frame after %.1f ms", ms);
+            firstFrame = false;
+        }
+    }
+    return true;
 }
 
-bool checkCol(RectF p, RectF w) {
-    return (p.x < w.x + w.w && p.x + p.w > w.x &&
-            p.y < w.y + w.h && p.y + p.h > w.y);
+bool TakePress(Button* b, Uint64 tickEnd, bool lastTick) {
+    if (!b->justPressed || (b->pressPerf > tickEnd && !lastTick)) return false;
+    b->justPressed = false;
+    return true;
 }
 
-SDL_Texture* LoadTex(const char* path, bool colorKey) {
-    SDL_Surface* tempSurface = IMG_Load(path);
-    if (!tempSurface) {
-        SDL_Surface* fallback = SDL_CreateRGBSurface(0, 32, 32, 32, 0,0,0,0);
-        SDL_FillRect(fallback, NULL, SDL_MapRGB(fallback->format, 255, 0, 255));
-        SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, fallback);
-        SDL_FreeSurface(fallback);
-        return tex;
-    }
-    if (colorKey) {
-        SDL_SetColorKey(tempSurface, SDL_TRUE, SDL_MapRGB(tempSurface->format, 0, 0, 0));
+void WaitUntil(Uint64 target) {
+    Uint64 freq = SDL_GetPerformanceFrequency();
+    for (;;) {
+        Uint64 now = SDL_GetPerformanceCounter();
+        if (now >= target) return;
+        Uint64 ms = (target - now) * 1000 / freq;
+        if (ms >= 2) SDL_Delay((Uint32)(ms - 1));
     }
-    SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, tempSurface);
-    SDL_FreeSurface(tempSurface);
-    return tex;
 }
 
-void RenderText(SDL_Renderer* r, TTF_Font* font, const char* text, int x, int y, SDL_Color color, bool alignRight) {
-    if (!font) return;
-    SDL_Surface* surf = TTF_RenderText_Solid(font, text, color);
-    if (!surf) return;
-    SDL_Texture* tex = SDL_CreateTextureFromSurface(r, surf);
-    int drawX = alignRight ? x - surf->w : x;
-    SDL_Rect dst = { drawX, y, surf->w, surf->h };
-    SDL_RenderCopy(r, tex, NULL, &dst);
-    SDL_DestroyTexture(tex);
-    SDL_FreeSurface(surf);
+void DrawChunks(RectF view) {
+    SDL_Color cPlatform = {100, 100, 120, 255};
+    for (int c = 0; c < STREAM_SLOTS; c++) {
+        const Chunk* ch = &streamer->chunks[c];
+        if (SDL_AtomicGet((SDL_atomic_t*)&ch->state) != CHUNK_READY) continue;
+        RectF bounds = { (float)ch->cx * CHUNK_SIZE, (float)ch->cy * CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE };
+        if (!checkCol(bounds, view)) continue;
+        for (int i = 0; i < ch->numTiles; i++) {
+            const RectF* t = &ch->tiles[i];
+            if (!checkCol(*t, view)) continue;
+            SDL_FRect dst = { (int)t->x - (int)view.x, (int)t->y - (int)view.y, (int)t->w, (int)t->h };
+            BatchSprite(batch, renderer, sprites->white, dst, SDL_FLIP_NONE, cPlatform);
+        }
+    }
 }
 
-void SpawnGhost(Player* p, int fx, int fy) {
-    ghosts[ghostHead].x = p->x;
-    ghosts[ghostHead].y = p->y;
-    ghosts[ghostHead].frameX = fx;
-    ghosts[ghostHead].frameY = fy;
-    ghosts[ghostHead].facingRight = p->facingRight;
-    ghosts[ghostHead].alpha = 0.6f; 
-    ghostHead = (ghostHead + 1) % MAX_GHOSTS;
+void DrawEntities(const RenderSnapshot* snap, RectF view, float interp) {
+    SDL_Color cEnemy = {255, 140, 140, 255};
+    SDL_Color cMover = {140, 140, 170, 255};
+    SDL_Color cShot = {255, 220, 120, 255};
+    for (int i = 0; i < snap->numEntities; i++) {
+        const SnapEntity* e = &snap->entities[i];
+        float x = Lerp(e->prevX, e->x, interp) - (int)view.x;
+        float y = Lerp(e->prevY, e->y, interp) - (int)view.y;
+        if (x > view.w || y > view.h || x + DRAW_SIZE < -DRAW_SIZE || y + DRAW_SIZE < -DRAW_SIZE) continue;
+
+        if (e->kind == ENT_ENEMY) {
+            SDL_Rect src = AtlasRegion(sprites, SPR_KNIGHT, e->frameX, e->frameY, SPRITE_SIZE, SPRITE_SIZE);
+            SDL_FRect dst = { (int)(x + ENEMY_W / 2 - DRAW_SIZE / 2), (int)(y + ENEMY_H - (DRAW_SIZE - SPRITE_OFFSET_Y)), DRAW_SIZE, DRAW_SIZE };
+            BatchSprite(batch, renderer, src, dst, (e->flags & ENT_FACING_RIGHT) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE, cEnemy);
+        } else {
+            SDL_FRect dst = { (int)x, (int)y, e->w, e->h };
+            BatchSprite(batch, renderer, sprites->white, dst, SDL_FLIP_NONE, e->kind == ENT_MOVER ? cMover : cShot);
+        }
+    }
 }
 
-void Respawn(Player* p) {
-    p->x = p->startX;
-    p->y = p->startY;
-    p->vx = 0; p->vy = 0;
-    p->idleDeathTimer = IDLE_DEATH_TIME;
-    p->scaleX = 0.1f; p->scaleY = 2.0f;
+void HeadlessInput(uint64_t tick, SimInput* in) {
+    int phase = (int)(tick % 480);
+    *in = (SimInput){0};
+    in->right = phase < 240;
+    in->left = phase >= 240;
+    in->jumpPressed = (tick % 90) == 0;
+    in->jumpHeld = (tick % 90) < 20;
+    in->dashPressed = (tick % 150) == 75;
+    in->attackPressed = (tick % 200) == 130;
 }
 
-bool IsPointInRect(float x, float y, SDL_Rect r) {
-    return (x >= r.x && x <= r.x + r.w && y >= r.y && y <= r.y + r.h);
+int RunHeadless(const Level* level, long ticks, float dt, Replay* replay, int rollbackWindow) {
+    bool netplay = rollbackWindow > 0;
+    SimState sim;
+    SimInit(&sim, level);
+    SimInput input;
+    if (netplay) InitRollback(&rollback, &sim, rollbackWindow);
+
+    if (replay) ticks = replay->count;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (long i = 0; i < ticks; i++) {
+        if (replay) NextReplayInput(replay, &input);
+        else HeadlessInput((uint64_t)i, &input);
+        if (netplay) {
+            SendInput(&transport, (uint64_t)i, &input);
+            DeliverInputs(&transport, &rollback);
+            RollbackStep(&rollback, &sim, level, dt);
+        } else {
+            SimStep(&sim, level, &input, dt);
+        }
+        WorldStep(&world, level, jobs, dt);
+    }
+    while (netplay && (sim.tick < (uint64_t)ticks || rollback.frontier < (uint64_t)ticks)) {
+        DeliverInputs(&transport, &rollback);
+        if (sim.tick < (uint64_t)ticks) RollbackStep(&rollback, &sim, level, dt);
+    }
+    if (netplay) RollbackSync(&rollback, &sim, level, dt);
+    double elapsed = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+
+    printf("headless: %ld ticks in %.3f s (%.0f ticks/s)\n", ticks, elapsed, elapsed > 0 ? ticks / elapsed : 0.0);
+    printf("headless: player at %.2f, %.2f (%d level rects)\n", sim.player.x, sim.player.y, level->numRects);
+    printf("headless: state hash %016llx\n", (unsigned long long)SimHash(&sim));
+    if (netplay) RollbackReport(&rollback);
+    if (world.count > 0) {
+        printf("headless: %d entities on %d threads, world hash %016llx\n",
+            world.count, jobs ? jobs->numThreads : 1, (unsigned long long)WorldHash(&world));
+    }
+    return 0;
 }
 
-void TouchToGameCoords(float normX, float normY, float* outX, float* outY) {
-    int winW, winH;
-    SDL_GetWindowSize(window, &winW, &winH);
+int RunSweep(const Level* level, int numSets, float spread, float dt, const char* outPath) {
+    MoveParams* params = malloc(sizeof(MoveParams) * (size_t)numSets);
+    TuneResult* results = malloc(sizeof(TuneResult) * (size_t)numSets * (size_t)numTuneScripts);
+    if (!params || !results) { free(params); free(results); return 1; }
+    GenerateMoveParams(params, numSets, spread, 1);
+
+    TuneSweep sweep = { level, dt, params, numSets, tuneScripts, numTuneScripts, results };
+    Uint64 start = SDL_GetPerformanceCounter();
+    RunTuneSweep(&sweep, jobs);
+    double elapsed = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+    fprintf(stderr, "sweep: %d runs on %d threads in %.3f s\n", numSets * numTuneScripts, jobs ? jobs->numThreads : 1, elapsed);
+
+    bool ok = WriteTuneResults(&sweep, outPath);
+    if (!ok) fprintf(stderr, "sweep: cannot write %s\n", outPath);
+    free(params);
+    free(results);
+    return ok ? 0 : 1;
+}
 
-    float scaleX = (float)winW / gameW;
-    float scaleY = (float)winH / gameH;
-    float scale = (scaleX < scaleY) ? scaleX : scaleY;
+int MakeTestLevel(const char* path, int numTiles) {
+    RectF* rects = malloc(sizeof(RectF) * (size_t)(numTiles + 1));
+    if (!rects) return 1;
+    rects[0] = (RectF){ -50, 280, 2000, 80 };
+    for (int i = 0; i < numTiles; i++) {
+        rects[i + 1] = (RectF){ 2000.0f + (i % 1000) * 40.0f, 240.0f - (i / 1000) * 40.0f, 32, 32 };
+    }
+    bool ok = SaveLevel(path, rects, numTiles + 1, 50, 200);
+    free(rects);
+    printf("level: wrote %d rects to %s\n", numTiles + 1, path);
+    return ok ? 0 : 1;
+}
 
-    float viewW = gameW * scale;
-    float viewH = gameH * scale;
+int main(int argc, char* argv[]) {
 
-    float offX = (winW - viewW) / 2.0f;
-    float offY = (winH - viewH) / 2.0f;
+    Uint64 launchPerf = SDL_GetPerformanceCounter();
+    int simHz = SIM_HZ;
+    int maxFps = 0;
+    long headlessTicks = 0;
+    long maxFrames = 0;
+    int sweepSets = 0;
+    float sweepSpread = 0.25f;
+    const char* sweepPath = NULL;
+    int numActors = 0;
+    int numThreads = 0;
+    int audioBuffer = AUDIO_BUFFER;
+    const char* levelPath = "level1.lvl";
+    const char* recordPath = NULL;
+    const char* replayPath = NULL;
+    bool uncapped = false;
+    bool showProfiler = false;
+    bool threaded = false;
+    bool lateInput = false;
+    bool probeLatency = false;
+    bool lowResMode = false;
+    bool dynamicRes = false;
+    bool integerScale = false;
+    bool powerSave = true;
+    int rollbackLatency = -1;
+    int rollbackJitter = 0;
+    int rollbackWindow = ROLLBACK_WINDOW;
+    const char* profilePath = NULL;
+    const char* capturePath = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--hz") == 0 && i + 1 < argc) simHz = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) maxFps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--headless") == 0) {
+            headlessTicks = (i + 1 < argc && argv[i + 1][0] != '-') ? atol(argv[++i]) : 0;
+            if (headlessTicks <= 0) headlessTicks = 1000000;
+        }
+        else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) maxFrames = atol(argv[++i]);
+        else if (strcmp(argv[i], "--level") == 0 && i + 1 < argc) levelPath = argv[++i];
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) recordPath = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) replayPath = argv[++i];
+        else if (strcmp(argv[i], "--uncapped") == 0) uncapped = true;
+        else if (strcmp(argv[i], "--profile") == 0) showProfiler = true;
+        else if (strcmp(argv[i], "--threaded") == 0) threaded = true;
+        else if (strcmp(argv[i], "--late-input") == 0) lateInput = true;
+        else if (strcmp(argv[i], "--latency-probe") == 0) probeLatency = true;
+        else if (strcmp(argv[i], "--lowres") == 0) lowResMode = true;
+        else if (strcmp(argv[i], "--dynamic-res") == 0) lowResMode = dynamicRes = true;
+        else if (strcmp(argv[i], "--integer-scale") == 0) integerScale = true;
+        else if (strcmp(argv[i], "--no-power-save") == 0) powerSave = false;
+        else if (strcmp(argv[i], "--profile-out") == 0 && i + 1 < argc) profilePath = argv[++i];
+        else if (strcmp(argv[i], "--capture") == 0 && i + 1 < argc) capturePath = argv[++i];
+        else if (strcmp(argv[i], "--make-level") == 0 && i + 2 < argc) {
+            return MakeTestLevel(argv[i + 1], atoi(argv[i + 2]));
+        }
+        else if (strcmp(argv[i], "--actors") == 0 && i + 1 < argc) {
+            numActors = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--sweep") == 0 && i + 1 < argc) {
+            sweepSets = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--sweep-spread") == 0 && i + 1 < argc) {
+            sweepSpread = (float)atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--sweep-out") == 0 && i + 1 < argc) {
+            sweepPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            numThreads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--rollback-latency") == 0 && i + 1 < argc) {
+            rollbackLatency = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--rollback-jitter") == 0 && i + 1 < argc) {
+            rollbackJitter = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--rollback-window") == 0 && i + 1 < argc) {
+            rollbackWindow = atoi(argv[++i]);
+            if (rollbackWindow < 1) rollbackWindow = 1;
+        }
+        else if (strcmp(argv[i], "--audio-buffer") == 0 && i + 1 < argc) {
+            audioBuffer = atoi(argv[++i]);
+            if (audioBuffer < 64) audioBuffer = 64;
+        }
+        else if (strcmp(argv[i], "--bake-bundle") == 0 && i + 1 < argc) {
+            IMG_Init(IMG_INIT_PNG);
+            bool ok = BakeAssetBundle(&assetManifest, argv[i + 1]);
+            IMG_Quit();
+            return ok ? 0 : 1;
+        }
+    }
+    Replay* replay = NULL;
+    if (replayPath) {
+        replay = LoadReplay(replayPath);
+        if (!replay) { fprintf(stderr, "replay: cannot load %s\n", replayPath); return 1; }
+        simHz = replay->simHz;
+        recordPath = NULL;
+    }
+    if (simHz < 30) simHz = 30;
+    const float simDt = 1.0f / simHz;
+    Replay* recording = recordPath ? CreateReplay(simHz) : NULL;
+
+    Level* level = LoadLevel(levelPath);
+    if (!level) level = CreateDefaultLevel();
+    if (!level) return 1;
+
+    ClearWorld(&world, 1);
+    if (numActors > 0) {
+        PopulateWorld(&world, level, numActors);
+        jobs = CreateJobSystem(numThreads);
+    }
 
-    float touchWinX = normX * winW;
-    float touchWinY = normY * winH;
+    if (sweepSets > 0) {
+        if (!jobs) jobs = CreateJobSystem(numThreads);
+        int rc = RunSweep(level, sweepSets, sweepSpread, simDt, sweepPath);
+        DestroyJobSystem(jobs);
+        FreeReplay(replay);
+        FreeLevel(level);
+        return rc;
+    }
 
-    *outX = (touchWinX - offX) / scale;
-    *outY = (touchWinY - offY) / scale;
-}
+    bool netplay = rollbackLatency >= 0;
+    if (netplay) InitLoopback(&transport, (rollbackLatency * simHz + 999) / 1000, (rollbackJitter * simHz + 999) / 1000, 1);
 
-int main(int argc, char* argv[]) {
+    if (headlessTicks > 0) {
+        int rc = RunHeadless(level, headlessTicks, simDt, replay, netplay ? rollbackWindow : 0);
+        DestroyJobSystem(jobs);
+        FreeReplay(replay);
+        FreeLevel(level);
+        return rc;
+    }
 
     SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO);
     IMG_Init(IMG_INIT_PNG);
     TTF_Init();
-    Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048);
+    Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, audioBuffer);
+    sfx = CreateSfxMixer();
 
     window = SDL_CreateWindow("Knight Smooth", 0, 0, 0, 0, SDL_WINDOW_FULLSCREEN_DESKTOP | SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-
-    texKnight = LoadTex("knight.png", true);
-    SDL_Texture* texA = LoadTex("a.png", false);
-    SDL_Texture* texB = LoadTex("b.png", false);
-    SDL_Texture* texY = LoadTex("y.png", false);
-
-    texPadBlank = LoadTex("blank.png", false);
-    texPadLeft  = LoadTex("left.png", false);
-    texPadRight = LoadTex("right.png", false);
-    texPadUp    = LoadTex("up.png", false);
-    texPadDown  = LoadTex("down.png", false);
-
-    fontBold = TTF_OpenFont("PixelAE-Bold.ttf", 24);
-    bgMusic = Mix_LoadMUS("japanese_8bit.mp3");
-    if (bgMusic) Mix_PlayMusic(bgMusic, -1);
-
-    Player player = { 
-        50, 200, 50, 200, 
-        0, 0, true, 
-        0.0f, 0, 0, 0, 
-        false, 0.0f, 0.0f,
-        0.0f, 0.0f, false, false,
-        IDLE_DEATH_TIME, 1.0f, 1.0f
-    };
-    RectF platform = { -50, 280, 2000, 80 }; 
-
-    DPad dPad = { {0,0,0,0}, false, false, false, false, false, 0, 1.0f };
-    Button btnJump   = { 0, false, {0,0,0,0}, false, false, texA, 1.0f }; 
-    Button btnAttack = { 0, false, {0,0,0,0}, false, false, texB, 1.0f };
-    Button btnDash   = { 0, false, {0,0,0,0}, false, false, texY, 1.0f };
+    Uint32 rendererFlags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE;
+    if (!uncapped) rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+    renderer = SDL_CreateRenderer(window, -1, rendererFlags);
+    if (integerScale) SDL_RenderSetIntegerScale(renderer, SDL_TRUE);
+
+    assets = StartAssetLoader(&assetManifest);
+    batch = CreateSpriteBatch();
+    if (!assets || !batch) return 1;
+    if (!ShowLoadingScreen(launchPerf)) {
+        FreeAssetLoader(assets);
+        return 0;
+    }
+    if (!sprites) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "sprite atlas: %s", SDL_GetError());
+        return 1;
+    }
+
+    InitRunner(&runner, level, &world, &particles, jobs, simDt);
+    runner.replay = replay;
+    runner.recording = recording;
+    runner.sfx = sfx;
+    if (netplay) {
+        InitRollback(&rollback, &runner.sim, rollbackWindow);
+        runner.rollback = &rollback;
+        runner.transport = &transport;
+    }
+
+    streamer = CreateChunkStreamer(level);
+    if (!streamer) return 1;
+
+    DPad dPad = { {0,0,0,0}, false, false, false, false, false, 0, 1.0f, SPR_PAD_BLANK };
+    Button btnJump   = { 0, false, {0,0,0,0}, false, false, SPR_BTN_A, 1.0f, 0 }; 
+    Button btnAttack = { 0, false, {0,0,0,0}, false, false, SPR_BTN_B, 1.0f, 0 };
+    Button btnDash   = { 0, false, {0,0,0,0}, false, false, SPR_BTN_Y, 1.0f, 0 };
 
     bool isRunning = true;
     SDL_Event event;
     Uint64 lastPerf = SDL_GetPerformanceCounter();
+    double accumulator = 0.0;
     int lastScreenW = 0, lastScreenH = 0;
-
-    for(int i=0; i<MAX_GHOSTS; i++) ghosts[i].alpha = 0.0f;
+    long replayFrame = 0;
+    long framesRun = 0;
+    bool loggedInteractive = false;
+    Uint64 perfFreq = SDL_GetPerformanceFrequency();
+    SDL_DisplayMode mode;
+    int refreshRate = (SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(window), &mode) == 0 && mode.refresh_rate > 0) ? mode.refresh_rate : 60;
+    Uint64 refreshPerf = perfFreq / (Uint64)refreshRate;
+    Uint64 lastPresentPerf = 0;
+    double workEma = 0.0;
+    uint32_t shownResponses[PROBE_COUNT] = {0};
+    InitResolution(&resolution, 1000.0 / refreshRate, RES_MIN_SCALE);
+    InitPower(&power, powerSave && !replay && !capturePath && !probeLatency && maxFrames == 0, POWER_IDLE_FPS);
+    CaptureSession* capture = NULL;
+    ProfilerInit();
 
     while (isRunning) {
 
@@ -238,6 +459,18 @@ int main(int argc, char* argv[]) {
         SDL_GetRendererOutputSize(renderer, &screenW, &screenH);
         if (screenH <= 0) { SDL_Delay(100); continue; }
 
+        WaitForPowerFrame(&power);
+        if (lateInput && !threaded && lastPresentPerf && !power.throttled) {
+            Uint64 budget = (Uint64)(workEma * 1.5) + perfFreq / 1000;
+            if (budget < refreshPerf) WaitUntil(lastPresentPerf + refreshPerf - budget);
+        }
+        Uint64 workStart = SDL_GetPerformanceCounter();
+        ProfilerBeginFrame();
+        if (!bgMusic && TakeAsset(assets, ASSET_MUSIC)) {
+            bgMusic = assets->music;
+            if (bgMusic) Mix_PlayMusic(bgMusic, -1);
+        }
+        ProfilerBegin(PROF_LAYOUT);
         if (screenW != lastScreenW || screenH != lastScreenH) {
             lastScreenW = screenW; lastScreenH = screenH;
             float ratio = (float)screenW / (float)screenH;
@@ -245,31 +478,51 @@ int main(int argc, char* argv[]) {
             gameH = FIXED_HEIGHT;
             SDL_RenderSetLogicalSize(renderer, gameW, gameH);
 
-            dPad.area = (SDL_Rect){ UI_MARGIN, gameH - DPAD_SIZE - UI_MARGIN, DPAD_SIZE, DPAD_SIZE };
-
-            int startX = gameW - UI_MARGIN - BTN_SIZE;
-            int startY = gameH - UI_MARGIN - BTN_SIZE;
-            btnJump.area = (SDL_Rect){ startX, startY, BTN_SIZE, BTN_SIZE };
-            btnAttack.area = (SDL_Rect){ startX - BTN_SIZE - 10, startY, BTN_SIZE, BTN_SIZE };
-            int midX = btnAttack.area.x + (btnJump.area.x + btnJump.area.w - btnAttack.area.x)/2 - BTN_SIZE/2;
-            btnDash.area = (SDL_Rect){ midX, startY - BTN_SIZE - 10, BTN_SIZE, BTN_SIZE };
+            Button* layoutBtns[] = { &btnJump, &btnAttack, &btnDash };
+            if (!LayoutHud(&hud, renderer, &dPad, layoutBtns, gameW, gameH)) SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "hud: %s", SDL_GetError());
+            SetRunnerView(&runner, gameW, gameH);
+            if (lowResMode && !ResizeLowRes(&lowRes, renderer, gameW, gameH)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "low-res target: %s", SDL_GetError());
+                lowResMode = dynamicRes = false;
+            }
+            if (capture && !ResizeCapture(capture, gameW, gameH)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "capture: %s, stopping", SDL_GetError());
+                StopCapture(capture);
+                capture = NULL;
+                capturePath = NULL;
+            }
+            if (capturePath && !capture && !(capture = StartCapture(renderer, capturePath, gameW, gameH))) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "capture: %s", SDL_GetError());
+                capturePath = NULL;
+            }
         }
+        if (threaded && !runner.thread && !StartSimThread(&runner, replay && uncapped)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "sim thread: %s", SDL_GetError());
+            StopSimThread(&runner);
+            threaded = false;
+        }
+        ProfilerEnd(PROF_LAYOUT);
 
         Uint64 nowPerf = SDL_GetPerformanceCounter();
-        double dt = (double)((nowPerf - lastPerf) / (double)SDL_GetPerformanceFrequency());
+        double frameTime = (double)((nowPerf - lastPerf) / (double)SDL_GetPerformanceFrequency());
         lastPerf = nowPerf;
-        if (dt > 0.05) dt = 0.05;
-        globalTimer += dt;
-
-        btnJump.justPressed = false; btnJump.justReleased = false;
-        btnDash.justPressed = false; btnAttack.justPressed = false;
+        if (frameTime > MAX_FRAME_TIME) frameTime = MAX_FRAME_TIME;
+        accumulator += frameTime;
+        if (replay && uncapped) accumulator = simDt;
 
+        ProfilerBegin(PROF_EVENTS);
+        bool hadEvent = false;
         while (SDL_PollEvent(&event)) {
+            hadEvent = true;
             if (event.type == SDL_QUIT) isRunning = false;
+            if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F3) showProfiler = !showProfiler;
+            if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) InvalidateHud(&hud);
 
             if (event.type == SDL_FINGERDOWN || event.type == SDL_FINGERUP || event.type == SDL_FINGERMOTION) {
                 float tx, ty;
-                TouchToGameCoords(event.tfinger.x, event.tfinger.y, &tx, &ty);
+                int winW, winH;
+                SDL_GetWindowSize(window, &winW, &winH);
+                TouchToGameCoords(winW, winH, gameW, gameH, event.tfinger.x, event.tfinger.y, &tx, &ty);
                 SDL_FingerID fid = event.tfinger.fingerId;
                 bool isDown = (event.type == SDL_FINGERDOWN);
                 bool isUp = (event.type == SDL_FINGERUP);
@@ -296,258 +549,222 @@ int main(int argc, char* argv[]) {
                     }
                 }
 
-                #define CHECK_BTN(btn) \
+                #define CHECK_BTN(btn, kind) \
                     if (isDown && IsPointInRect(tx, ty, btn.area) && !btn.active) { \
                         btn.active = true; btn.fingerId = fid; btn.justPressed = true; \
+                        btn.pressPerf = EventPerf(event.tfinger.timestamp); \
+                        if (probeLatency) ProbeInput(&probe, kind, btn.pressPerf, shownResponses[kind]); \
                     } \
                     else if (isUp && btn.active && btn.fingerId == fid) { \
                         btn.active = false; btn.justReleased = true; \
                     }
-                CHECK_BTN(btnJump);
-                CHECK_BTN(btnAttack);
-                CHECK_BTN(btnDash);
+                CHECK_BTN(btnJump, PROBE_JUMP);
+                CHECK_BTN(btnAttack, PROBE_ATTACK);
+                CHECK_BTN(btnDash, PROBE_DASH);
             }
         }
+        ProfilerEnd(PROF_EVENTS);
 
         Button* allBtns[] = { &btnJump, &btnAttack, &btnDash };
-        for(int i=0; i<3; i++) {
-            float target = allBtns[i]->active ? 0.85f : 1.0f; 
-            allBtns[i]->currentScale = Lerp(allBtns[i]->currentScale, target, 25.0f * dt);
-        }
-        float padTarget = dPad.active ? 0.95f : 1.0f;
-        dPad.scale = Lerp(dPad.scale, padTarget, 25.0f * dt);
-
-        player.scaleX = Lerp(player.scaleX, 1.0f, 15.0f * dt);
-        player.scaleY = Lerp(player.scaleY, 1.0f, 15.0f * dt);
-
-        if (player.coyoteTimer > 0) player.coyoteTimer -= dt;
-        if (player.jumpBufferTimer > 0) player.jumpBufferTimer -= dt;
-        if (player.dashCooldownTimer > 0) player.dashCooldownTimer -= dt;
-        if (player.dashTimer > 0) player.dashTimer -= dt;
-        if (player.dashTimer <= 0) player.isDashing = false;
-
-        bool isMoving = (fabs(player.vx) > 10.0f) || player.isDashing || player.isAttacking || !player.onGround;
-        if (isMoving) player.idleDeathTimer = IDLE_DEATH_TIME;
-        else {
-            player.idleDeathTimer -= dt;
-            if (player.idleDeathTimer <= 0) Respawn(&player);
-        }
-
-        if (btnAttack.justPressed && !player.isDashing && !player.isAttacking) {
-            player.isAttacking = true;
-            player.state = 4; player.currentFrame = 0; player.animTimer = 0;
-            player.vx = 0; 
-        }
-
-        if (btnDash.justPressed && player.dashCooldownTimer <= 0 && !player.isAttacking) {
-            player.isDashing = true;
-            player.dashTimer = DASH_DURATION;
-            player.dashCooldownTimer = DASH_COOLDOWN;
-            player.vx = (player.facingRight ? 1 : -1) * DASH_SPEED;
-            player.vy = 0; 
-            player.state = 3;
-            player.scaleX = 1.4f; player.scaleY = 0.6f;
-        }
-
-        bool jumpRequested = btnJump.justPressed;
-
-        if (dPad.up && player.onGround && player.jumpBufferTimer <= 0) {
-            jumpRequested = true;
-        }
-        if (jumpRequested) player.jumpBufferTimer = 0.1f;
-
-        bool isJumpHeld = btnJump.active || dPad.up;
-
-        if (player.isAttacking) {
-            player.vx = Lerp(player.vx, 0, 10.0f * dt);
-            player.vy += GRAVITY * dt;
-        }
-        else if (player.isDashing) {
-            player.vx = (player.facingRight ? 1 : -1) * DASH_SPEED;
-            player.vy = 0;
-            SpawnGhost(&player, 340, 40);
-        } 
-        else {
-
-            float dir = 0.0f;
-            if (dPad.left) dir -= 1.0f;
-            if (dPad.right) dir += 1.0f;
-            if (dPad.left && dPad.right) dir = 0.0f;
-
-            float targetSpeed = dir * MAX_SPEED;
-            float accel = player.onGround ? ACCEL_GROUND : ACCEL_AIR;
-            float friction = player.onGround ? FRICTION_GROUND : FRICTION_AIR;
-
-            if (dir != 0) {
-                if (player.vx * dir < 0) player.vx = Lerp(player.vx, targetSpeed, 10.0f * dt);
-                else {
-                    if (dir > 0 && player.vx < targetSpeed) player.vx += accel * dt;
-                    else if (dir < 0 && player.vx > targetSpeed) player.vx -= accel * dt;
-                }
-                player.facingRight = (dir > 0);
-            } else {
-                if (player.vx > 0) {
-                    player.vx -= friction * dt;
-                    if (player.vx < 0) player.vx = 0;
-                } else if (player.vx < 0) {
-                    player.vx += friction * dt;
-                    if (player.vx > 0) player.vx = 0;
-                }
+        const RenderSnapshot* snap = &frameSnap;
+        float interp;
+        if (threaded) {
+            SimInput input = {
+                dPad.left, dPad.right, dPad.up, dPad.down,
+                btnJump.active,
+                btnJump.justPressed, btnAttack.justPressed, btnDash.justPressed
+            };
+            PublishInput(&runner, &input);
+            AnimateControls(&dPad, allBtns, (float)frameTime);
+            btnJump.justPressed = false; btnJump.justReleased = false;
+            btnDash.justPressed = false; btnAttack.justPressed = false;
+            if (SDL_AtomicGet(&runner.finished)) isRunning = false;
+
+            snap = AcquireSnapshot(&runner);
+            double since = (double)(SDL_GetPerformanceCounter() - snap->publishPerf) / (double)SDL_GetPerformanceFrequency();
+            interp = (float)(since / simDt);
+            if (interp > 1.0f) interp = 1.0f;
+            if (replay) {
+                dPad.left = snap->input.left; dPad.right = snap->input.right;
+                dPad.up = snap->input.up; dPad.down = snap->input.down;
             }
+        } else {
+            int ticks = 0;
+            Uint64 simBase = nowPerf - (Uint64)(accumulator * (double)perfFreq);
+            while (accumulator >= simDt && ticks < MAX_TICKS_PER_FRAME) {
+                Uint64 tickEnd = simBase + (Uint64)((ticks + 1) * simDt * (double)perfFreq);
+                bool lastTick = accumulator - simDt < simDt || ticks + 1 == MAX_TICKS_PER_FRAME;
+                SimInput input = {
+                    dPad.left, dPad.right, dPad.up, dPad.down,
+                    btnJump.active,
+                    TakePress(&btnJump, tickEnd, lastTick),
+                    TakePress(&btnAttack, tickEnd, lastTick),
+                    TakePress(&btnDash, tickEnd, lastTick)
+                };
+                if (!NextTickInput(&runner, &input)) { isRunning = false; break; }
+                if (replay) {
+                    dPad.left = input.left; dPad.right = input.right;
+                    dPad.up = input.up; dPad.down = input.down;
+                }
+                RunnerTick(&runner, &input, true);
+                AnimateControls(&dPad, allBtns, simDt);
+                btnJump.justReleased = false;
 
-            if (player.vx > MAX_SPEED) player.vx = MAX_SPEED;
-            if (player.vx < -MAX_SPEED) player.vx = -MAX_SPEED;
-
-            if (player.jumpBufferTimer > 0 && player.coyoteTimer > 0) {
-                player.vy = JUMP_FORCE;
-                player.onGround = false;
-                player.coyoteTimer = 0; player.jumpBufferTimer = 0;
-                player.scaleX = 0.7f; player.scaleY = 1.3f; 
-            }
-
-            if (player.vy < -200.0f && !isJumpHeld) {
-                player.vy *= 0.6f; 
-
-            }
-
-            if (!player.onGround) player.state = 2; 
-            else if (fabs(player.vx) > 20) player.state = 1; 
-            else player.state = 0; 
-
-            player.vy += GRAVITY * dt;
-        }
-
-        player.x += player.vx * dt;
-        player.y += player.vy * dt;
-
-        float feetY = player.y + DRAW_SIZE - SPRITE_OFFSET_Y;
-        RectF pRect = { player.x + DRAW_SIZE/2 - 10, feetY - 40, 20, 40 };
-        bool wasOnGround = player.onGround;
-        player.onGround = false;
-
-        if (checkCol(pRect, platform)) {
-            float penetration = (pRect.y + pRect.h) - platform.y;
-            if (player.vy >= 0 && penetration < 50.0f) {
-                player.y = platform.y - (DRAW_SIZE - SPRITE_OFFSET_Y);
-                player.vy = 0;
-                player.onGround = true;
-                player.coyoteTimer = 0.1f;
-                if (!wasOnGround) { player.scaleX = 1.3f; player.scaleY = 0.7f; }
+                accumulator -= simDt;
+                ticks++;
             }
-        } else if (wasOnGround && player.vy >= 0 && !player.isDashing) {
-            player.coyoteTimer = 0.1f;
+            if (accumulator >= simDt) accumulator = fmod(accumulator, simDt);
+            interp = (float)(accumulator / simDt);
+            CaptureSnapshot(&runner, &frameSnap);
         }
+        const Player* player = &snap->player;
 
-        if (player.y > 600) Respawn(&player);
-
-        if (player.state != player.lastState) {
-            if (player.state != 2) { player.currentFrame = 0; player.animTimer = 0; }
-            player.lastState = player.state;
+        ProfilerBegin(PROF_HUD);
+        char timeBuffer[32];
+        char idleBuffer[32] = "";
+        int min = (int)(snap->globalTimer / 60);
+        int sec = (int)(snap->globalTimer) % 60;
+        int ms  = (int)((snap->globalTimer - (int)snap->globalTimer) * 100);
+        sprintf(timeBuffer, "%02d:%02d:%02d", min, sec, ms);
+        if (player->idleDeathTimer < IDLE_DEATH_TIME) sprintf(idleBuffer, "%.2f", player->idleDeathTimer);
+        Button* hudBtns[] = { &btnDash, &btnAttack, &btnJump };
+        bool wasThrottled = power.throttled;
+        UpdatePower(&power, !hadEvent && HudSettled(&dPad, hudBtns) && SceneAtRest(snap), frameTime);
+        int hudRedraws = hud.redraws;
+        UpdateHud(&hud, renderer, batch, sprites, textAtlas, &dPad, hudBtns, timeBuffer, idleBuffer);
+        ProfilerEnd(PROF_HUD);
+        if (wasThrottled && power.throttled && hud.redraws == hudRedraws) {
+            power.skippedPresents++;
+            ProfilerEndFrame();
+            continue;
         }
 
-        int srcX = 0, srcY = 0;
-        if (player.isDashing) { srcX = 340; srcY = 40; } 
-        else if (player.isAttacking) {
-            player.animTimer += dt;
-            if (player.animTimer >= 0.08f) {
-                player.animTimer = 0; player.currentFrame++;
-                if (player.currentFrame >= 4) { player.isAttacking = false; player.currentFrame = 0; player.state = 0; }
-            }
-            srcY = 40; srcX = 300 + (player.currentFrame * 20);
+        if (capture) {
+            ProfilerBegin(PROF_CAPTURE);
+            BeginCaptureFrame(capture);
+            ProfilerEnd(PROF_CAPTURE);
         }
-        else {
-            player.animTimer += dt;
-            if (player.state == 0) { 
-
-                if (player.animTimer > 0.3f) { player.animTimer = 0; player.currentFrame = (player.currentFrame + 1) % 2; }
-                srcX = ARMED_OFFSET_X + (player.currentFrame * 20); srcY = 40;
-            } else if (player.state == 1) { 
 
-                if (player.animTimer > 0.1f) { player.animTimer = 0; player.currentFrame = (player.currentFrame + 1) % 4; }
-                srcX = ARMED_OFFSET_X + (player.currentFrame * 20); srcY = 140;
-            } else if (player.state == 2) { 
+        ProfilerBegin(PROF_WORLD);
+        if (lowResMode) BeginLowRes(&lowRes, renderer, resolution.scale);
+        SDL_SetRenderDrawColor(renderer, 20, 20, 30, 255);
+        SDL_RenderClear(renderer);
 
-                srcY = 140; 
-                if (player.vy < -400) srcX = 200; else if (player.vy > 400) srcX = 240; else srcX = 220; 
-            }
+        BatchBegin(batch, sprites->tex);
+        SDL_Color cOpaque = {255, 255, 255, 255};
+
+        RectF view = CameraView(&snap->camera, interp, (float)gameW, (float)gameH);
+        int camX = (int)view.x, camY = (int)view.y;
+        StreamAround(streamer, view);
+        DrawChunks(view);
+        DrawEntities(snap, view, interp);
+
+        SDL_RendererFlip flip = player->facingRight ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+        if (player->isAttacking) flip = player->facingRight ? SDL_FLIP_NONE : SDL_FLIP_HORIZONTAL;
+
+        const ParticlePool* parts = &snap->particles;
+        for (int i = 0; i < parts->count; i++) {
+            float pAlpha = Lerp(parts->prevAlpha[i], parts->alpha[i], interp);
+            if (pAlpha <= 0) continue;
+            Uint32 c = parts->color[i];
+            SDL_Color pColor = { (Uint8)(c >> 16), (Uint8)(c >> 8), (Uint8)c, (Uint8)(pAlpha * 255) };
+            SDL_Rect pSrc = (parts->frameX[i] < 0) ? sprites->white :
+                AtlasRegion(sprites, SPR_KNIGHT, parts->frameX[i], parts->frameY[i], SPRITE_SIZE, SPRITE_SIZE);
+            float px = Lerp(parts->prevX[i], parts->x[i], interp) - camX;
+            float py = Lerp(parts->prevY[i], parts->y[i], interp) - camY;
+            if (px > gameW || py > gameH || px + DRAW_SIZE < 0 || py + DRAW_SIZE < 0) continue;
+            SDL_FRect pDst = { (int)px, (int)py, parts->size[i], parts->size[i] };
+            SDL_RendererFlip pFlip = parts->flip[i] ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+            BatchSprite(batch, renderer, pSrc, pDst, pFlip, pColor);
         }
 
-        SDL_SetRenderDrawColor(renderer, 20, 20, 30, 255);
-        SDL_RenderClear(renderer);
+        int finalW = (int)(DRAW_SIZE * player->scaleX);
+        int finalH = (int)(DRAW_SIZE * player->scaleY);
+        float drawX = Lerp(player->prevX, player->x, interp);
+        float drawY = Lerp(player->prevY, player->y, interp);
+        int finalX = (int)(drawX + (DRAW_SIZE - finalW) / 2.0f) - camX;
+        int finalY = (int)(drawY + (DRAW_SIZE - finalH)) - camY;
+        SDL_Rect src = AtlasRegion(sprites, SPR_KNIGHT, player->frameX, player->frameY, SPRITE_SIZE, SPRITE_SIZE);
+        SDL_FRect dst = { finalX, finalY, finalW, finalH };
+        BatchSprite(batch, renderer, src, dst, flip, cOpaque);
+        BatchFlush(batch, renderer);
+        if (lowResMode) EndLowRes(&lowRes, renderer, resolution.scale);
+        ProfilerEnd(PROF_WORLD);
+
+        ProfilerBegin(PROF_TEXT);
+        DrawHud(&hud, renderer, batch);
+        if (showProfiler) ProfilerDrawOverlay(renderer, textAtlas, 10, 10);
+        ProfilerEnd(PROF_TEXT);
+
+        if (capture) {
+            ProfilerBegin(PROF_CAPTURE);
+            EndCaptureFrame(capture);
+            ProfilerEnd(PROF_CAPTURE);
+        }
 
-        SDL_SetRenderDrawColor(renderer, 100, 100, 120, 255);
-        SDL_Rect rPlatform = { (int)platform.x, (int)platform.y, (int)platform.w, (int)platform.h };
-        SDL_RenderFillRect(renderer, &rPlatform);
-
-        SDL_RendererFlip flip = player.facingRight ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-        if (player.isAttacking) flip = player.facingRight ? SDL_FLIP_NONE : SDL_FLIP_HORIZONTAL;
-
-        for(int i=0; i<MAX_GHOSTS; i++) {
-            if (ghosts[i].alpha > 0) {
-                SDL_SetTextureAlphaMod(texKnight, (Uint8)(ghosts[i].alpha * 255));
-                SDL_Rect gSrc = { ghosts[i].frameX, ghosts[i].frameY, SPRITE_SIZE, SPRITE_SIZE };
-                SDL_Rect gDst = { (int)ghosts[i].x, (int)ghosts[i].y, DRAW_SIZE, DRAW_SIZE };
-                SDL_RendererFlip gFlip = ghosts[i].facingRight ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-                SDL_RenderCopyEx(renderer, texKnight, &gSrc, &gDst, 0, NULL, gFlip);
-                ghosts[i].alpha -= 3.0f * dt; 
+        ProfilerBegin(PROF_PRESENT);
+        Uint64 presentStart = SDL_GetPerformanceCounter();
+        SDL_RenderPresent(renderer);
+        Uint64 prevPresentPerf = lastPresentPerf;
+        lastPresentPerf = SDL_GetPerformanceCounter();
+        ProfilerEnd(PROF_PRESENT);
+        workEma = workEma * 0.9 + (double)(presentStart - workStart) * 0.1;
+        if (dynamicRes && prevPresentPerf && !wasThrottled && !power.throttled) {
+            double intervalMs = (double)(lastPresentPerf - prevPresentPerf) * 1000.0 / (double)perfFreq;
+            double workMs = (double)(presentStart - workStart) * 1000.0 / (double)perfFreq;
+            if (UpdateResolution(&resolution, intervalMs, workMs)) {
+                SDL_Log("resolution: world at %dx%d", (int)ceilf(gameW * resolution.scale), (int)ceilf(gameH * resolution.scale));
             }
         }
-        SDL_SetTextureAlphaMod(texKnight, 255); 
-
-        int finalW = (int)(DRAW_SIZE * player.scaleX);
-        int finalH = (int)(DRAW_SIZE * player.scaleY);
-        int finalX = (int)(player.x + (DRAW_SIZE - finalW) / 2.0f);
-        int finalY = (int)(player.y + (DRAW_SIZE - finalH)); 
-        SDL_Rect src = { srcX, srcY, SPRITE_SIZE, SPRITE_SIZE };
-        SDL_Rect dst = { finalX, finalY, finalW, finalH };
-        SDL_RenderCopyEx(renderer, texKnight, &src, &dst, 0, NULL, flip);
-
-        SDL_Rect rPad = dPad.area;
-        int pw = (int)(rPad.w * dPad.scale);
-        int ph = (int)(rPad.h * dPad.scale);
-        int px = rPad.x + (rPad.w - pw)/2;
-        int py = rPad.y + (rPad.h - ph)/2;
-        SDL_Rect dstPad = { px, py, pw, ph };
-
-        SDL_RenderCopy(renderer, texPadBlank, NULL, &dstPad);
-        if (dPad.left)  SDL_RenderCopy(renderer, texPadLeft, NULL, &dstPad);
-        if (dPad.right) SDL_RenderCopy(renderer, texPadRight, NULL, &dstPad);
-        if (dPad.up)    SDL_RenderCopy(renderer, texPadUp, NULL, &dstPad);
-        if (dPad.down)  SDL_RenderCopy(renderer, texPadDown, NULL, &dstPad);
-
-        Button* btns[] = { &btnDash, &btnAttack, &btnJump };
-        for (int i=0; i<3; i++) {
-            SDL_Rect r = btns[i]->area;
-            int w = (int)(r.w * btns[i]->currentScale);
-            int h = (int)(r.h * btns[i]->currentScale);
-            int x = r.x + (r.w - w) / 2;
-            int y = r.y + (r.h - h) / 2;
-            SDL_Rect dstBtn = { x, y, w, h };
-            SDL_RenderCopy(renderer, btns[i]->tex, NULL, &dstBtn);
+        if (probeLatency) ProbePresented(&probe, snap->responses, lastPresentPerf);
+        memcpy(shownResponses, snap->responses, sizeof(shownResponses));
+        ProfilerEndFrame();
+
+        if (!loggedInteractive) {
+            double ms = (double)(SDL_GetPerformanceCounter() - launchPerf) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+            SDL_Log("startup: first interactive frame after %.1f ms", ms);
+            loggedInteractive = true;
         }
 
-        char timeBuffer[32];
-        int min = (int)(globalTimer / 60);
-        int sec = (int)(globalTimer) % 60;
-        int ms  = (int)((globalTimer - (int)globalTimer) * 100);
-        sprintf(timeBuffer, "%02d:%02d:%02d", min, sec, ms);
-        SDL_Color cWhite = {255, 255, 255, 255};
-        RenderText(renderer, fontBold, timeBuffer, gameW - 10, 10, cWhite, true);
+        if (replay) {
+            double frameMs = (double)(SDL_GetPerformanceCounter() - nowPerf) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+            printf("replay: frame %ld tick %llu %.3f ms\n", replayFrame++, (unsigned long long)snap->tick, frameMs);
+        }
 
-        if (player.idleDeathTimer < IDLE_DEATH_TIME) {
-            sprintf(timeBuffer, "%.2f", player.idleDeathTimer);
-            SDL_Color cRed = {255, 50, 50, 255};
-            RenderText(renderer, fontBold, timeBuffer, gameW - 10, 40, cRed, true);
+        if (maxFps > 0) {
+            double spent = (double)(SDL_GetPerformanceCounter() - nowPerf) / (double)SDL_GetPerformanceFrequency();
+            double budget = 1.0 / maxFps;
+            if (spent < budget) SDL_Delay((Uint32)((budget - spent) * 1000.0));
         }
+        if (maxFrames > 0 && ++framesRun >= maxFrames) isRunning = false;
+    }
 
-        SDL_RenderPresent(renderer);
+    StopSimThread(&runner);
+    StopCapture(capture);
+    if (probeLatency) ProbeReport(&probe);
+    if (netplay) RollbackReport(&rollback);
+    PowerReport(&power);
+    if (replay) {
+        printf("replay: %llu ticks, state hash %016llx\n", (unsigned long long)runner.sim.tick, (unsigned long long)SimHash(&runner.sim));
+        FreeReplay(replay);
+    }
+    if (profilePath && !ProfilerWrite(profilePath)) fprintf(stderr, "profiler: cannot write %s\n", profilePath);
+    if (recording) {
+        if (!SaveReplay(recording, recordPath)) fprintf(stderr, "replay: cannot write %s\n", recordPath);
+        FreeReplay(recording);
     }
 
-    SDL_DestroyTexture(texKnight);
-    SDL_DestroyTexture(texA); SDL_DestroyTexture(texB); SDL_DestroyTexture(texY);
-    SDL_DestroyTexture(texPadBlank); SDL_DestroyTexture(texPadLeft); 
-    SDL_DestroyTexture(texPadRight); SDL_DestroyTexture(texPadUp); SDL_DestroyTexture(texPadDown);
+    DestroyHud(&hud);
+    DestroyLowRes(&lowRes);
+    DestroyChunkStreamer(streamer);
+    DestroyJobSystem(jobs);
+    DestroySpriteBatch(batch);
+    DestroyTextureAtlas(sprites);
+    DestroyGlyphAtlas(textAtlas);
+    FreeLevel(level);
+    DestroySfxMixer(sfx);
     Mix_FreeMusic(bgMusic); TTF_CloseFont(fontBold);
+    FreeAssetLoader(assets);
     SDL_DestroyRenderer(renderer); SDL_DestroyWindow(window);
     Mix_Quit(); TTF_Quit(); IMG_Quit(); SDL_Quit();
     return 0;
@@ -0,0 +1,47 @@
+#include "mapfile.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool MapFile(const char* path, MappedFile* out) {
+    *out = (MappedFile){ NULL, 0, false };
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) { close(fd); return false; }
+    size_t size = (size_t)st.st_size;
+    void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+    *out = (MappedFile){ data, size, true };
+    return true;
+#else
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    void* data = (len > 0) ? malloc((size_t)len) : NULL;
+    if (!data || fread(data, 1, (size_t)len, f) != (size_t)len) { free(data); fclose(f); return false; }
+    fclose(f);
+    *out = (MappedFile){ data, (size_t)len, false };
+    return true;
+#endif
+}
+
+void UnmapFile(MappedFile* file) {
+    if (!file->data) return;
+#ifndef _WIN32
+    if (file->mapped) munmap(file->data, file->size);
+    else
+#endif
+    free(file->data);
+    *file = (MappedFile){ NULL, 0, false };
+}
@@ -0,0 +1,16 @@
+#ifndef MAPFILE_H
+#define MAPFILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct {
+    void* data;
+    size_t size;
+    bool mapped;
+} MappedFile;
+
+bool MapFile(const char* path, MappedFile* out);
+void UnmapFile(MappedFile* file);
+
+#endif
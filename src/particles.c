@@ -0,0 +1,102 @@
+#include "particles.h"
+#include <string.h>
+
+void ClearParticles(ParticlePool* pool) {
+    pool->count = 0;
+    pool->seed = 0x9E3779B9u;
+}
+
+int EmitParticle(ParticlePool* pool, const ParticleDesc* d) {
+    if (pool->count == MAX_PARTICLES) return -1;
+    int i = pool->count++;
+    pool->x[i] = pool->prevX[i] = d->x;
+    pool->y[i] = pool->prevY[i] = d->y;
+    pool->vx[i] = d->vx;
+    pool->vy[i] = d->vy;
+    pool->ay[i] = d->ay;
+    pool->alpha[i] = pool->prevAlpha[i] = d->alpha;
+    pool->fade[i] = d->fade;
+    pool->size[i] = d->size;
+    pool->frameX[i] = (int16_t)d->frameX;
+    pool->frameY[i] = (int16_t)d->frameY;
+    pool->flip[i] = d->flip;
+    pool->color[i] = d->color;
+    return i;
+}
+
+float ParticleRandom(ParticlePool* pool, float lo, float hi) {
+    pool->seed = pool->seed * 1664525u + 1013904223u;
+    return lo + (hi - lo) * ((pool->seed >> 8) * (1.0f / 16777216.0f));
+}
+
+static void MoveParticle(ParticlePool* pool, int from, int to) {
+    pool->x[to] = pool->x[from];
+    pool->y[to] = pool->y[from];
+    pool->prevX[to] = pool->prevX[from];
+    pool->prevY[to] = pool->prevY[from];
+    pool->vx[to] = pool->vx[from];
+    pool->vy[to] = pool->vy[from];
+    pool->ay[to] = pool->ay[from];
+    pool->alpha[to] = pool->alpha[from];
+    pool->prevAlpha[to] = pool->prevAlpha[from];
+    pool->fade[to] = pool->fade[from];
+    pool->size[to] = pool->size[from];
+    pool->frameX[to] = pool->frameX[from];
+    pool->frameY[to] = pool->frameY[from];
+    pool->flip[to] = pool->flip[from];
+    pool->color[to] = pool->color[from];
+}
+
+static void Integrate(int n, float* restrict pos, float* restrict prev, const float* restrict vel, float dt) {
+    for (int i = 0; i < n; i++) {
+        prev[i] = pos[i];
+        pos[i] += vel[i] * dt;
+    }
+}
+
+static void Accelerate(int n, float* restrict vel, const float* restrict acc, float dt) {
+    for (int i = 0; i < n; i++) vel[i] += acc[i] * dt;
+}
+
+void UpdateParticles(ParticlePool* pool, float dt) {
+    int n = pool->count;
+
+    Accelerate(n, pool->vy, pool->ay, dt);
+    Integrate(n, pool->x, pool->prevX, pool->vx, dt);
+    Integrate(n, pool->y, pool->prevY, pool->vy, dt);
+
+    float* restrict alpha = pool->alpha;
+    float* restrict prevAlpha = pool->prevAlpha;
+    const float* restrict fade = pool->fade;
+    for (int i = 0; i < n; i++) {
+        prevAlpha[i] = alpha[i];
+        alpha[i] -= fade[i] * dt;
+    }
+
+    int i = 0;
+    while (i < n) {
+        if (alpha[i] <= 0.0f && prevAlpha[i] <= 0.0f) {
+            n--;
+            if (i != n) MoveParticle(pool, n, i);
+        } else {
+            i++;
+        }
+    }
+    pool->count = n;
+}
+
+void CopyParticles(ParticlePool* dst, const ParticlePool* src) {
+    size_t n = (size_t)src->count;
+    dst->count = src->count;
+    dst->seed = src->seed;
+    memcpy(dst->x, src->x, n * sizeof(float)); memcpy(dst->y, src->y, n * sizeof(float));
+    memcpy(dst->prevX, src->prevX, n * sizeof(float)); memcpy(dst->prevY, src->prevY, n * sizeof(float));
+    memcpy(dst->vx, src->vx, n * sizeof(float)); memcpy(dst->vy, src->vy, n * sizeof(float));
+    memcpy(dst->ay, src->ay, n * sizeof(float));
+    memcpy(dst->alpha, src->alpha, n * sizeof(float)); memcpy(dst->prevAlpha, src->prevAlpha, n * sizeof(float));
+    memcpy(dst->fade, src->fade, n * sizeof(float));
+    memcpy(dst->size, src->size, n * sizeof(float));
+    memcpy(dst->frameX, src->frameX, n * sizeof(int16_t)); memcpy(dst->frameY, src->frameY, n * sizeof(int16_t));
+    memcpy(dst->flip, src->flip, n * sizeof(uint8_t));
+    memcpy(dst->color, src->color, n * sizeof(uint32_t));
+}
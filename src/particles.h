@@ -0,0 +1,41 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include <stdint.h>
+
+#define MAX_PARTICLES 4096
+
+typedef struct {
+    float x, y;
+    float vx, vy;
+    float ay;
+    float alpha, fade;
+    float size;
+    int frameX, frameY;
+    uint8_t flip;
+    uint32_t color;
+} ParticleDesc;
+
+typedef struct {
+    int count;
+    uint32_t seed;
+
+    float x[MAX_PARTICLES], y[MAX_PARTICLES];
+    float prevX[MAX_PARTICLES], prevY[MAX_PARTICLES];
+    float vx[MAX_PARTICLES], vy[MAX_PARTICLES];
+    float ay[MAX_PARTICLES];
+    float alpha[MAX_PARTICLES], prevAlpha[MAX_PARTICLES];
+    float fade[MAX_PARTICLES];
+    float size[MAX_PARTICLES];
+    int16_t frameX[MAX_PARTICLES], frameY[MAX_PARTICLES];
+    uint8_t flip[MAX_PARTICLES];
+    uint32_t color[MAX_PARTICLES];
+} ParticlePool;
+
+void ClearParticles(ParticlePool* pool);
+int EmitParticle(ParticlePool* pool, const ParticleDesc* d);
+void UpdateParticles(ParticlePool* pool, float dt);
+void CopyParticles(ParticlePool* dst, const ParticlePool* src);
+float ParticleRandom(ParticlePool* pool, float lo, float hi);
+
+#endif
@@ -0,0 +1,53 @@
+#include "power.h"
+#include <math.h>
+#include <stdio.h>
+
+void InitPower(PowerMode* p, bool enabled, int idleFps) {
+    *p = (PowerMode){0};
+    p->enabled = enabled;
+    p->idleFps = idleFps > 0 ? idleFps : POWER_IDLE_FPS;
+}
+
+bool SceneAtRest(const RenderSnapshot* snap) {
+    const Player* pl = &snap->player;
+    if (pl->isDashing || pl->isAttacking || !pl->onGround) return false;
+    if (pl->vx != 0 || pl->vy != 0 || pl->x != pl->prevX || pl->y != pl->prevY) return false;
+    if (fabsf(pl->scaleX - 1.0f) > POWER_REST_EPSILON || fabsf(pl->scaleY - 1.0f) > POWER_REST_EPSILON) return false;
+    if (snap->particles.count > 0) return false;
+
+    const Camera* cam = &snap->camera;
+    if (fabsf(cam->x - cam->prevX) > POWER_REST_EPSILON || fabsf(cam->y - cam->prevY) > POWER_REST_EPSILON) return false;
+
+    for (int i = 0; i < snap->numEntities; i++) {
+        const SnapEntity* e = &snap->entities[i];
+        if (e->x != e->prevX || e->y != e->prevY) return false;
+    }
+    return true;
+}
+
+void UpdatePower(PowerMode* p, bool still, double frameTime) {
+    if (!p->enabled || !still) {
+        p->stillTime = 0;
+        p->throttled = false;
+        return;
+    }
+    p->stillTime += frameTime;
+    p->throttled = p->stillTime >= POWER_IDLE_DELAY;
+    if (p->throttled) {
+        p->throttledFrames++;
+        p->nextFrame = SDL_GetPerformanceCounter() + SDL_GetPerformanceFrequency() / (Uint64)p->idleFps;
+    }
+}
+
+void WaitForPowerFrame(const PowerMode* p) {
+    if (!p->throttled) return;
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (now >= p->nextFrame) return;
+    Uint64 ms = (p->nextFrame - now) * 1000 / SDL_GetPerformanceFrequency();
+    if (ms > 0) SDL_WaitEventTimeout(NULL, (int)ms);
+}
+
+void PowerReport(const PowerMode* p) {
+    if (!p->enabled) return;
+    printf("power: %ld throttled frames, %ld presents skipped\n", p->throttledFrames, p->skippedPresents);
+}
@@ -0,0 +1,29 @@
+#ifndef POWER_H
+#define POWER_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+#include "runner.h"
+
+#define POWER_IDLE_FPS 20
+#define POWER_IDLE_DELAY 0.5
+#define POWER_REST_EPSILON 0.002f
+
+typedef struct {
+    bool enabled;
+    bool throttled;
+    int idleFps;
+    double stillTime;
+    Uint64 nextFrame;
+    long throttledFrames;
+    long skippedPresents;
+} PowerMode;
+
+void InitPower(PowerMode* p, bool enabled, int idleFps);
+bool SceneAtRest(const RenderSnapshot* snap);
+void UpdatePower(PowerMode* p, bool still, double frameTime);
+void WaitForPowerFrame(const PowerMode* p);
+void PowerReport(const PowerMode* p);
+
+#endif
@@ -0,0 +1,163 @@
+#include "profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* phaseNames[PROF_COUNT] = {
+    "frame", "layout", "events", "sim", "particles", "world", "hud", "text", "capture", "present"
+};
+
+static ProfileFrame history[PROFILER_HISTORY];
+static ProfileFrame current;
+static Uint64 frameCount = 0;
+static Uint64 pending[PROF_COUNT];
+static Uint64 epoch = 0;
+static double msPerTick = 0.0;
+
+void ProfilerInit(void) {
+    memset(history, 0, sizeof(history));
+    memset(&current, 0, sizeof(current));
+    frameCount = 0;
+    epoch = SDL_GetPerformanceCounter();
+    msPerTick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+void ProfilerBeginFrame(void) {
+    memset(&current, 0, sizeof(current));
+    ProfilerBegin(PROF_FRAME);
+}
+
+void ProfilerEndFrame(void) {
+    ProfilerEnd(PROF_FRAME);
+    history[frameCount % PROFILER_HISTORY] = current;
+    frameCount++;
+}
+
+void ProfilerBegin(int phase) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    pending[phase] = now;
+    if (current.start[phase] == 0) current.start[phase] = now;
+}
+
+void ProfilerEnd(int phase) {
+    current.ticks[phase] += SDL_GetPerformanceCounter() - pending[phase];
+}
+
+static int CompareFloat(const void* a, const void* b) {
+    float fa = *(const float*)a, fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+float ProfilerPercentile(int phase, float pct) {
+    static float samples[PROFILER_GRAPH_FRAMES];
+    int n = frameCount < PROFILER_GRAPH_FRAMES ? (int)frameCount : PROFILER_GRAPH_FRAMES;
+    if (n == 0) return 0.0f;
+    for (int i = 0; i < n; i++) {
+        const ProfileFrame* f = &history[(frameCount - 1 - i) % PROFILER_HISTORY];
+        samples[i] = (float)(f->ticks[phase] * msPerTick);
+    }
+    qsort(samples, (size_t)n, sizeof(float), CompareFloat);
+    int idx = (int)(pct * (n - 1) + 0.5f);
+    return samples[idx];
+}
+
+void ProfilerDrawOverlay(SDL_Renderer* r, GlyphAtlas* text, int x, int y) {
+    static SDL_Point graph[PROFILER_GRAPH_FRAMES];
+    const int graphH = 60;
+    const float pxPerMs = graphH / 33.3f;
+
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(r, 0, 0, 0, 170);
+    SDL_Rect bg = { x, y, PROFILER_GRAPH_FRAMES + 180, graphH + 8 + PROF_COUNT * 14 };
+    SDL_RenderFillRect(r, &bg);
+
+    int n = frameCount < PROFILER_GRAPH_FRAMES ? (int)frameCount : PROFILER_GRAPH_FRAMES;
+    for (int i = 0; i < n; i++) {
+        const ProfileFrame* f = &history[(frameCount - n + i) % PROFILER_HISTORY];
+        float ms = (float)(f->ticks[PROF_FRAME] * msPerTick);
+        int h = (int)(ms * pxPerMs);
+        if (h > graphH) h = graphH;
+        graph[i] = (SDL_Point){ x + 4 + i, y + 4 + graphH - h };
+    }
+    SDL_SetRenderDrawColor(r, 80, 80, 80, 255);
+    int budgetY = y + 4 + graphH - (int)(16.7f * pxPerMs);
+    SDL_RenderDrawLine(r, x + 4, budgetY, x + 4 + PROFILER_GRAPH_FRAMES, budgetY);
+    SDL_SetRenderDrawColor(r, 90, 230, 120, 255);
+    if (n > 1) SDL_RenderDrawLines(r, graph, n);
+
+    char line[TEXT_MAX_CHARS];
+    SDL_Color cText = {230, 230, 230, 255};
+    for (int p = 0; p < PROF_COUNT; p++) {
+        snprintf(line, sizeof(line), "%-9s %5.2f %5.2f", phaseNames[p],
+                 ProfilerPercentile(p, 0.50f), ProfilerPercentile(p, 0.99f));
+        RenderText(r, text, line, x + 4, y + graphH + 8 + p * 14, cText, false);
+    }
+}
+
+static bool EndsWith(const char* s, const char* suffix) {
+    size_t ls = strlen(s), lx = strlen(suffix);
+    return ls >= lx && strcmp(s + ls - lx, suffix) == 0;
+}
+
+static bool WriteSummary(FILE* f, Uint64 first, Uint64 n) {
+    float* samples = malloc(sizeof(float) * (size_t)(n ? n : 1));
+    if (!samples) return false;
+    for (int p = 0; p < PROF_COUNT; p++) {
+        double sum = 0.0;
+        for (Uint64 i = 0; i < n; i++) {
+            samples[i] = (float)(history[(first + i) % PROFILER_HISTORY].ticks[p] * msPerTick);
+            sum += samples[i];
+        }
+        if (n == 0) continue;
+        qsort(samples, (size_t)n, sizeof(float), CompareFloat);
+        fprintf(f, "{\"suite\":\"frame\",\"name\":\"%s\",\"frames\":%llu,\"ms_mean\":%.4f,\"ms_p50\":%.4f,\"ms_p95\":%.4f,\"ms_max\":%.4f}\n",
+                phaseNames[p], (unsigned long long)n, sum / n, samples[n / 2], samples[(n * 95) / 100], samples[n - 1]);
+    }
+    free(samples);
+    return true;
+}
+
+bool ProfilerWrite(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+
+    Uint64 n = frameCount < PROFILER_HISTORY ? frameCount : PROFILER_HISTORY;
+    Uint64 first = frameCount - n;
+    bool csv = EndsWith(path, ".csv");
+    if (EndsWith(path, ".jsonl")) {
+        bool ok = WriteSummary(f, first, n);
+        fclose(f);
+        return ok;
+    }
+
+    if (csv) {
+        fprintf(f, "frame");
+        for (int p = 0; p < PROF_COUNT; p++) fprintf(f, ",%s_ms", phaseNames[p]);
+        fprintf(f, "\n");
+    } else {
+        fprintf(f, "{\"traceEvents\":[\n");
+    }
+
+    bool firstEvent = true;
+    for (Uint64 i = first; i < frameCount; i++) {
+        const ProfileFrame* fr = &history[i % PROFILER_HISTORY];
+        if (csv) {
+            fprintf(f, "%llu", (unsigned long long)i);
+            for (int p = 0; p < PROF_COUNT; p++) fprintf(f, ",%.4f", fr->ticks[p] * msPerTick);
+            fprintf(f, "\n");
+            continue;
+        }
+        for (int p = 0; p < PROF_COUNT; p++) {
+            if (fr->start[p] == 0) continue;
+            double ts = (fr->start[p] - epoch) * msPerTick * 1000.0;
+            double dur = fr->ticks[p] * msPerTick * 1000.0;
+            fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.1f,\"dur\":%.1f,\"pid\":1,\"tid\":%d}",
+                    firstEvent ? "" : ",\n", phaseNames[p], ts, dur, p == PROF_FRAME ? 0 : 1);
+            firstEvent = false;
+        }
+    }
+    if (!csv) fprintf(f, "\n]}\n");
+
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,41 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+#include "text.h"
+
+#define PROFILER_HISTORY 1024
+#define PROFILER_GRAPH_FRAMES 240
+
+enum {
+    PROF_FRAME,
+    PROF_LAYOUT,
+    PROF_EVENTS,
+    PROF_SIM,
+    PROF_PARTICLES,
+    PROF_WORLD,
+    PROF_HUD,
+    PROF_TEXT,
+    PROF_CAPTURE,
+    PROF_PRESENT,
+    PROF_COUNT
+};
+
+typedef struct {
+    Uint64 start[PROF_COUNT];
+    Uint64 ticks[PROF_COUNT];
+} ProfileFrame;
+
+void ProfilerInit(void);
+void ProfilerBeginFrame(void);
+void ProfilerEndFrame(void);
+void ProfilerBegin(int phase);
+void ProfilerEnd(int phase);
+
+float ProfilerPercentile(int phase, float pct);
+void ProfilerDrawOverlay(SDL_Renderer* r, GlyphAtlas* text, int x, int y);
+bool ProfilerWrite(const char* path);
+
+#endif
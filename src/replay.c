@@ -0,0 +1,104 @@
+#include "replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+uint8_t PackInput(const SimInput* in) {
+    return (uint8_t)((in->left << 0) | (in->right << 1) | (in->up << 2) | (in->down << 3) |
+                     (in->jumpHeld << 4) | (in->jumpPressed << 5) |
+                     (in->attackPressed << 6) | (in->dashPressed << 7));
+}
+
+void UnpackInput(uint8_t bits, SimInput* in) {
+    in->left          = (bits >> 0) & 1;
+    in->right         = (bits >> 1) & 1;
+    in->up            = (bits >> 2) & 1;
+    in->down          = (bits >> 3) & 1;
+    in->jumpHeld      = (bits >> 4) & 1;
+    in->jumpPressed   = (bits >> 5) & 1;
+    in->attackPressed = (bits >> 6) & 1;
+    in->dashPressed   = (bits >> 7) & 1;
+}
+
+Replay* CreateReplay(int simHz) {
+    Replay* rep = calloc(1, sizeof(Replay));
+    if (!rep) return NULL;
+    rep->simHz = simHz;
+    return rep;
+}
+
+void FreeReplay(Replay* rep) {
+    if (!rep) return;
+    free(rep->inputs);
+    free(rep);
+}
+
+void RecordInput(Replay* rep, const SimInput* in) {
+    if (rep->count == rep->capacity) {
+        uint32_t cap = rep->capacity ? rep->capacity * 2 : 8192;
+        uint8_t* grown = realloc(rep->inputs, cap);
+        if (!grown) return;
+        rep->inputs = grown;
+        rep->capacity = cap;
+    }
+    rep->inputs[rep->count++] = PackInput(in);
+}
+
+bool NextReplayInput(Replay* rep, SimInput* in) {
+    if (rep->cursor >= rep->count) return false;
+    UnpackInput(rep->inputs[rep->cursor++], in);
+    return true;
+}
+
+bool SaveReplay(const Replay* rep, const char* path) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+
+    ReplayHeader hdr = { REPLAY_MAGIC, REPLAY_VERSION, (uint32_t)rep->simHz, rep->count };
+    bool ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+
+    uint32_t i = 0;
+    while (ok && i < rep->count) {
+        uint8_t bits = rep->inputs[i];
+        uint32_t run = 1;
+        while (i + run < rep->count && rep->inputs[i + run] == bits && run < 0xFFFF) run++;
+        uint8_t rec[3] = { bits, (uint8_t)(run & 0xFF), (uint8_t)(run >> 8) };
+        ok = fwrite(rec, sizeof(rec), 1, f) == 1;
+        i += run;
+    }
+    fclose(f);
+    return ok;
+}
+
+Replay* LoadReplay(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+
+    ReplayHeader hdr;
+    if (fread(&hdr, sizeof(hdr), 1, f) != 1 || hdr.magic != REPLAY_MAGIC || hdr.version != REPLAY_VERSION) {
+        fclose(f);
+        return NULL;
+    }
+
+    Replay* rep = CreateReplay((int)hdr.simHz);
+    if (rep && hdr.numTicks > 0) {
+        rep->inputs = malloc(hdr.numTicks);
+        rep->capacity = rep->inputs ? hdr.numTicks : 0;
+    }
+    if (!rep || (hdr.numTicks > 0 && !rep->inputs)) {
+        FreeReplay(rep);
+        fclose(f);
+        return NULL;
+    }
+
+    uint8_t rec[3];
+    while (rep->count < hdr.numTicks && fread(rec, sizeof(rec), 1, f) == 1) {
+        uint32_t run = rec[1] | ((uint32_t)rec[2] << 8);
+        for (uint32_t k = 0; k < run && rep->count < hdr.numTicks; k++) rep->inputs[rep->count++] = rec[0];
+    }
+    fclose(f);
+
+    if (rep->count != hdr.numTicks) {
+        fprintf(stderr, "replay: %s is truncated (%u of %u ticks)\n", path, rep->count, hdr.numTicks);
+    }
+    return rep;
+}
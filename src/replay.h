@@ -0,0 +1,38 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sim.h"
+
+#define REPLAY_MAGIC 0x314C5052u
+#define REPLAY_VERSION 1
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t simHz;
+    uint32_t numTicks;
+} ReplayHeader;
+
+typedef struct {
+    uint8_t* inputs;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t cursor;
+    int simHz;
+} Replay;
+
+uint8_t PackInput(const SimInput* in);
+void UnpackInput(uint8_t bits, SimInput* in);
+
+Replay* CreateReplay(int simHz);
+void FreeReplay(Replay* rep);
+void RecordInput(Replay* rep, const SimInput* in);
+bool NextReplayInput(Replay* rep, SimInput* in);
+
+bool SaveReplay(const Replay* rep, const char* path);
+Replay* LoadReplay(const char* path);
+
+#endif
@@ -0,0 +1,67 @@
+#include "resolution.h"
+#include <math.h>
+
+bool ResizeLowRes(LowResTarget* t, SDL_Renderer* r, int w, int h) {
+    if (t->tex && t->w == w && t->h == h) return true;
+    DestroyLowRes(t);
+    t->tex = SDL_CreateTexture(r, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!t->tex) return false;
+    SDL_SetTextureScaleMode(t->tex, SDL_ScaleModeNearest);
+    t->w = w; t->h = h;
+    return true;
+}
+
+void BeginLowRes(LowResTarget* t, SDL_Renderer* r, float scale) {
+    t->prev = SDL_GetRenderTarget(r);
+    SDL_SetRenderTarget(r, t->tex);
+    SDL_RenderSetScale(r, scale, scale);
+}
+
+void EndLowRes(LowResTarget* t, SDL_Renderer* r, float scale) {
+    SDL_RenderSetScale(r, 1.0f, 1.0f);
+    SDL_SetRenderTarget(r, t->prev);
+    t->prev = NULL;
+    SDL_SetRenderDrawColor(r, 0, 0, 0, 255);
+    SDL_RenderClear(r);
+    SDL_Rect src = { 0, 0, (int)ceilf(t->w * scale), (int)ceilf(t->h * scale) };
+    SDL_Rect dst = { 0, 0, t->w, t->h };
+    SDL_RenderCopy(r, t->tex, &src, &dst);
+}
+
+void DestroyLowRes(LowResTarget* t) {
+    if (t->tex) SDL_DestroyTexture(t->tex);
+    t->tex = NULL;
+    t->w = t->h = 0;
+}
+
+void InitResolution(ResolutionController* c, double budgetMs, float minScale) {
+    *c = (ResolutionController){0};
+    c->scale = 1.0f;
+    c->minScale = minScale < RES_STEP ? RES_STEP : (minScale > 1.0f ? 1.0f : minScale);
+    c->budgetMs = budgetMs;
+}
+
+bool UpdateResolution(ResolutionController* c, double intervalMs, double workMs) {
+    c->workEma = c->workEma * 0.9 + workMs * 0.1;
+    if (c->cooldown > 0) { c->cooldown--; return false; }
+
+    bool missed = intervalMs > c->budgetMs * 1.2 || c->workEma > c->budgetMs * 0.9;
+    if (missed) {
+        c->calm = 0;
+        if (++c->misses < RES_MISS_FRAMES || c->scale - RES_STEP < c->minScale - 0.001f) return false;
+        c->misses = 0;
+        c->scale -= RES_STEP;
+        c->cooldown = RES_HOLD_FRAMES;
+        return true;
+    }
+
+    c->misses = 0;
+    if (c->workEma < c->budgetMs * 0.6) c->calm++;
+    else c->calm = 0;
+    if (c->calm < RES_RAISE_FRAMES || c->scale >= 1.0f) return false;
+    c->scale += RES_STEP;
+    if (c->scale > 1.0f) c->scale = 1.0f;
+    c->calm = 0;
+    c->cooldown = RES_HOLD_FRAMES;
+    return true;
+}
@@ -0,0 +1,37 @@
+#ifndef RESOLUTION_H
+#define RESOLUTION_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+#define RES_MIN_SCALE 0.5f
+#define RES_STEP 0.125f
+#define RES_HOLD_FRAMES 30
+#define RES_RAISE_FRAMES 120
+#define RES_MISS_FRAMES 3
+
+typedef struct {
+    SDL_Texture* tex;
+    SDL_Texture* prev;
+    int w, h;
+} LowResTarget;
+
+typedef struct {
+    float scale;
+    float minScale;
+    double budgetMs;
+    double workEma;
+    int cooldown;
+    int misses;
+    int calm;
+} ResolutionController;
+
+bool ResizeLowRes(LowResTarget* t, SDL_Renderer* r, int w, int h);
+void BeginLowRes(LowResTarget* t, SDL_Renderer* r, float scale);
+void EndLowRes(LowResTarget* t, SDL_Renderer* r, float scale);
+void DestroyLowRes(LowResTarget* t);
+
+void InitResolution(ResolutionController* c, double budgetMs, float minScale);
+bool UpdateResolution(ResolutionController* c, double intervalMs, double workMs);
+
+#endif
@@ -0,0 +1,150 @@
+#include "rollback.h"
+#include <stdio.h>
+#include <string.h>
+
+void InitLoopback(LoopbackTransport* t, int delayTicks, int jitterTicks, uint32_t seed) {
+    memset(t, 0, sizeof(*t));
+    if (delayTicks < 0) delayTicks = 0;
+    if (jitterTicks < 0) jitterTicks = 0;
+    if (delayTicks + jitterTicks > LOOPBACK_SLOTS / 2) delayTicks = LOOPBACK_SLOTS / 2 - jitterTicks;
+    t->delay = delayTicks;
+    t->jitter = jitterTicks;
+    t->rng = seed ? seed : 0x9E3779B9u;
+}
+
+bool SendInput(LoopbackTransport* t, uint64_t tick, const SimInput* in) {
+    int next = (t->tail + 1) % LOOPBACK_SLOTS;
+    if (next == t->head) return false;
+
+    uint64_t at = t->clock + (uint64_t)t->delay;
+    if (t->jitter > 0) {
+        t->rng ^= t->rng << 13; t->rng ^= t->rng >> 17; t->rng ^= t->rng << 5;
+        at += t->rng % (uint32_t)(t->jitter + 1);
+    }
+    if (t->head != t->tail) {
+        uint64_t last = t->deliverAt[(t->tail + LOOPBACK_SLOTS - 1) % LOOPBACK_SLOTS];
+        if (at < last) at = last;
+    }
+
+    t->packets[t->tail] = (InputPacket){ tick, *in };
+    t->deliverAt[t->tail] = at;
+    t->tail = next;
+    return true;
+}
+
+bool ReceiveInput(LoopbackTransport* t, InputPacket* out) {
+    if (t->head == t->tail || t->deliverAt[t->head] > t->clock) return false;
+    *out = t->packets[t->head];
+    t->head = (t->head + 1) % LOOPBACK_SLOTS;
+    return true;
+}
+
+static bool SameInput(const SimInput* a, const SimInput* b) {
+    return a->left == b->left && a->right == b->right && a->up == b->up && a->down == b->down &&
+           a->jumpHeld == b->jumpHeld && a->jumpPressed == b->jumpPressed &&
+           a->attackPressed == b->attackPressed && a->dashPressed == b->dashPressed;
+}
+
+static SimInput PredictInput(const RollbackSession* rb) {
+    SimInput in = rb->lastConfirmed;
+    in.jumpPressed = false;
+    in.attackPressed = false;
+    in.dashPressed = false;
+    return in;
+}
+
+void InitRollback(RollbackSession* rb, const SimState* s, int window) {
+    memset(rb, 0, sizeof(*rb));
+    if (window < 1) window = 1;
+    if (window > ROLLBACK_FRAMES - 1) window = ROLLBACK_FRAMES - 1;
+    rb->window = window;
+    rb->frontier = s->tick;
+    for (int i = 0; i < ROLLBACK_FRAMES; i++) rb->inputTick[i] = UINT64_MAX;
+}
+
+void ConfirmInput(RollbackSession* rb, uint64_t tick, const SimInput* in) {
+    if (tick < rb->frontier || tick >= rb->frontier + ROLLBACK_FRAMES) return;
+    int slot = (int)(tick % ROLLBACK_FRAMES);
+    if (rb->inputTick[slot] == tick) {
+        if (rb->confirmed[slot]) return;
+        if (!SameInput(&rb->inputs[slot], in)) {
+            if (!rb->mispredicted || tick < rb->rollbackFrom) rb->rollbackFrom = tick;
+            rb->mispredicted = true;
+        }
+    }
+    rb->inputs[slot] = *in;
+    rb->inputTick[slot] = tick;
+    rb->confirmed[slot] = true;
+
+    for (;;) {
+        int f = (int)(rb->frontier % ROLLBACK_FRAMES);
+        if (rb->inputTick[f] != rb->frontier || !rb->confirmed[f]) break;
+        rb->lastConfirmed = rb->inputs[f];
+        rb->frontier++;
+    }
+}
+
+void DeliverInputs(LoopbackTransport* t, RollbackSession* rb) {
+    InputPacket pkt;
+    t->clock++;
+    while (ReceiveInput(t, &pkt)) ConfirmInput(rb, pkt.tick, &pkt.input);
+}
+
+void RollbackSync(RollbackSession* rb, SimState* s, const Level* level, float dt) {
+    if (!rb->mispredicted) return;
+    rb->mispredicted = false;
+    uint64_t from = rb->rollbackFrom;
+    uint64_t to = s->tick;
+    if (from >= to) return;
+
+    memcpy(s, &rb->states[from % ROLLBACK_FRAMES], sizeof(*s));
+    SimInput predicted = PredictInput(rb);
+    uint32_t missed = 0;
+    for (uint64_t t = from; t < to; t++) {
+        int slot = (int)(t % ROLLBACK_FRAMES);
+        if (!rb->confirmed[slot]) rb->inputs[slot] = predicted;
+        memcpy(&rb->states[slot], s, sizeof(*s));
+        SimStep(s, level, &rb->inputs[slot], dt);
+        missed |= s->events & ~rb->emitted[slot];
+        rb->emitted[slot] |= s->events;
+    }
+    s->events = missed;
+    rb->rollbacks++;
+    rb->resimTicks += (long)(to - from);
+}
+
+bool RollbackStep(RollbackSession* rb, SimState* s, const Level* level, float dt) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    s->events = 0;
+    RollbackSync(rb, s, level, dt);
+    uint32_t missed = s->events;
+
+    bool advanced = false;
+    if (s->tick >= rb->frontier + (uint64_t)rb->window) {
+        rb->stalls++;
+        s->events = missed;
+    } else {
+        uint64_t t = s->tick;
+        int slot = (int)(t % ROLLBACK_FRAMES);
+        if (rb->inputTick[slot] != t || !rb->confirmed[slot]) {
+            rb->inputs[slot] = PredictInput(rb);
+            rb->inputTick[slot] = t;
+            rb->confirmed[slot] = false;
+        }
+        memcpy(&rb->states[slot], s, sizeof(*s));
+        SimStep(s, level, &rb->inputs[slot], dt);
+        rb->emitted[slot] = s->events;
+        s->events |= missed;
+        advanced = true;
+    }
+
+    Uint64 spent = SDL_GetPerformanceCounter() - start;
+    if (spent > rb->worstPerf) rb->worstPerf = spent;
+    return advanced;
+}
+
+void RollbackReport(const RollbackSession* rb) {
+    double worstMs = (double)rb->worstPerf * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    printf("rollback: %ld rollbacks, %ld resimulated ticks, %ld stalls, worst step %.3f ms\n",
+        rb->rollbacks, rb->resimTicks, rb->stalls, worstMs);
+}
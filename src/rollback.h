@@ -0,0 +1,58 @@
+#ifndef ROLLBACK_H
+#define ROLLBACK_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "level.h"
+#include "sim.h"
+
+#define ROLLBACK_FRAMES 64
+#define ROLLBACK_WINDOW 8
+#define LOOPBACK_SLOTS 256
+
+typedef struct {
+    uint64_t tick;
+    SimInput input;
+} InputPacket;
+
+typedef struct {
+    InputPacket packets[LOOPBACK_SLOTS];
+    uint64_t deliverAt[LOOPBACK_SLOTS];
+    int head, tail;
+    int delay, jitter;
+    uint64_t clock;
+    uint32_t rng;
+} LoopbackTransport;
+
+typedef struct {
+    SimState states[ROLLBACK_FRAMES];
+    SimInput inputs[ROLLBACK_FRAMES];
+    uint64_t inputTick[ROLLBACK_FRAMES];
+    bool confirmed[ROLLBACK_FRAMES];
+    uint32_t emitted[ROLLBACK_FRAMES];
+    SimInput lastConfirmed;
+    uint64_t frontier;
+    uint64_t rollbackFrom;
+    bool mispredicted;
+    int window;
+
+    long rollbacks;
+    long resimTicks;
+    long stalls;
+    Uint64 worstPerf;
+} RollbackSession;
+
+void InitLoopback(LoopbackTransport* t, int delayTicks, int jitterTicks, uint32_t seed);
+bool SendInput(LoopbackTransport* t, uint64_t tick, const SimInput* in);
+bool ReceiveInput(LoopbackTransport* t, InputPacket* out);
+
+void InitRollback(RollbackSession* rb, const SimState* s, int window);
+void ConfirmInput(RollbackSession* rb, uint64_t tick, const SimInput* in);
+void DeliverInputs(LoopbackTransport* t, RollbackSession* rb);
+void RollbackSync(RollbackSession* rb, SimState* s, const Level* level, float dt);
+bool RollbackStep(RollbackSession* rb, SimState* s, const Level* level, float dt);
+void RollbackReport(const RollbackSession* rb);
+
+#endif
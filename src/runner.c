@@ -0,0 +1,233 @@
+#include "anim.h"
+#include "runner.h"
+#include "profiler.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void SpawnGhost(SimRunner* r, int fx, int fy) {
+    const Player* p = &r->sim.player;
+    ParticleDesc d = {0};
+    d.x = p->prevX; d.y = p->prevY;
+    d.alpha = 0.6f; d.fade = 3.0f;
+    d.size = DRAW_SIZE;
+    d.frameX = fx; d.frameY = fy;
+    d.flip = p->facingRight;
+    d.color = 0xFFFFFF;
+    EmitParticle(r->particles, &d);
+}
+
+static void SpawnDust(SimRunner* r, int count) {
+    const Player* p = &r->sim.player;
+    ParticlePool* pool = r->particles;
+    float feetX = p->x + DRAW_SIZE / 2.0f;
+    float feetY = p->y + DRAW_SIZE - SPRITE_OFFSET_Y;
+    for (int i = 0; i < count; i++) {
+        ParticleDesc d = {0};
+        d.x = feetX + ParticleRandom(pool, -12.0f, 12.0f);
+        d.y = feetY - 4.0f;
+        d.vx = ParticleRandom(pool, -90.0f, 90.0f);
+        d.vy = ParticleRandom(pool, -70.0f, -20.0f);
+        d.ay = 240.0f;
+        d.alpha = 0.8f; d.fade = ParticleRandom(pool, 1.8f, 3.0f);
+        d.size = 4.0f;
+        d.frameX = -1; d.frameY = -1;
+        d.color = 0xC8C8D2;
+        EmitParticle(pool, &d);
+    }
+}
+
+static void PlayEffectSound(SimRunner* r, int clip, float volume) {
+    const Player* p = &r->sim.player;
+    float viewW = (float)SDL_AtomicGet(&r->viewW);
+    float pan = viewW > 0 ? (p->x + DRAW_SIZE / 2.0f - r->camera.x) / viewW * 2.0f - 1.0f : 0.0f;
+    PlaySfx(r->sfx, clip, volume, pan * 0.6f);
+}
+
+static void SpawnEffects(SimRunner* r) {
+    uint32_t events = r->sim.events;
+    if (events & SIM_EV_DASH_TRAIL) SpawnGhost(r, 340, 40);
+    if (events & SIM_EV_LAND) SpawnDust(r, 8);
+    if (events & SIM_EV_JUMP) SpawnDust(r, 4);
+
+    if (!r->sfx) return;
+    if (events & SIM_EV_JUMP) PlayEffectSound(r, SFX_JUMP, 0.8f);
+    if (events & SIM_EV_LAND) PlayEffectSound(r, SFX_LAND, 0.7f);
+    if (events & SIM_EV_DASH) PlayEffectSound(r, SFX_DASH, 0.8f);
+    if (events & SIM_EV_ATTACK) PlayEffectSound(r, SFX_ATTACK, 0.8f);
+}
+
+static void CameraTarget(SimRunner* r, float* x, float* y) {
+    const Player* p = &r->sim.player;
+    *x = p->x + DRAW_SIZE / 2.0f - SDL_AtomicGet(&r->viewW) / 2.0f;
+    *y = p->y + DRAW_SIZE / 2.0f - SDL_AtomicGet(&r->viewH) / 2.0f;
+}
+
+void InitRunner(SimRunner* r, const Level* level, World* world, ParticlePool* particles, JobSystem* jobs, float dt) {
+    *r = (SimRunner){0};
+    r->level = level;
+    r->world = world;
+    r->particles = particles;
+    r->jobs = jobs;
+    r->dt = dt;
+    r->back = 0; r->front = 2;
+    SDL_AtomicSet(&r->middle, 1);
+    SimInit(&r->sim, level);
+    ClearParticles(particles);
+}
+
+void SetRunnerView(SimRunner* r, int w, int h) {
+    bool first = SDL_AtomicGet(&r->viewW) == 0;
+    SDL_AtomicSet(&r->viewW, w);
+    SDL_AtomicSet(&r->viewH, h);
+    if (first && !r->thread) {
+        float x, y;
+        CameraTarget(r, &x, &y);
+        SnapCamera(&r->camera, x, y);
+    }
+}
+
+bool NextTickInput(SimRunner* r, SimInput* in) {
+    if (r->replay && !NextReplayInput(r->replay, in)) return false;
+    if (r->recording) RecordInput(r->recording, in);
+    return true;
+}
+
+void RunnerTick(SimRunner* r, const SimInput* in, bool profile) {
+    if (profile) ProfilerBegin(PROF_PARTICLES);
+    UpdateParticles(r->particles, r->dt);
+    if (profile) ProfilerEnd(PROF_PARTICLES);
+    if (profile) ProfilerBegin(PROF_SIM);
+    if (r->rollback) {
+        SendInput(r->transport, r->inputTick++, in);
+        DeliverInputs(r->transport, r->rollback);
+        RollbackStep(r->rollback, &r->sim, r->level, r->dt);
+    } else {
+        SimStep(&r->sim, r->level, in, r->dt);
+    }
+    WorldStep(r->world, r->level, r->jobs, r->dt);
+    if (profile) ProfilerEnd(PROF_SIM);
+    r->lastInput = *in;
+    if (r->sim.events & SIM_EV_JUMP) r->responses[PROBE_JUMP]++;
+    if (r->sim.events & SIM_EV_ATTACK) r->responses[PROBE_ATTACK]++;
+    if (r->sim.events & SIM_EV_DASH) r->responses[PROBE_DASH]++;
+    SpawnEffects(r);
+
+    float x, y;
+    CameraTarget(r, &x, &y);
+    UpdateCamera(&r->camera, x, y, r->dt);
+}
+
+void CaptureSnapshot(SimRunner* r, RenderSnapshot* snap) {
+    const World* w = r->world;
+    snap->tick = r->sim.tick;
+    snap->publishPerf = SDL_GetPerformanceCounter();
+    snap->player = r->sim.player;
+    snap->globalTimer = r->sim.globalTimer;
+    snap->input = r->lastInput;
+    memcpy(snap->responses, r->responses, sizeof(snap->responses));
+    snap->camera = r->camera;
+
+    const Camera* cam = &r->camera;
+    RectF area = {
+        fminf(cam->prevX, cam->x) - DRAW_SIZE, fminf(cam->prevY, cam->y) - DRAW_SIZE,
+        SDL_AtomicGet(&r->viewW) + fabsf(cam->x - cam->prevX) + DRAW_SIZE * 2,
+        SDL_AtomicGet(&r->viewH) + fabsf(cam->y - cam->prevY) + DRAW_SIZE * 2
+    };
+    int n = QueryWorld(w, area, r->scratch, SNAP_MAX_ENTITIES);
+    for (int k = 0; k < n; k++) {
+        int i = r->scratch[k];
+        SnapEntity* e = &snap->entities[k];
+        e->x = w->x[i]; e->y = w->y[i];
+        e->prevX = w->prevX[i]; e->prevY = w->prevY[i];
+        e->w = w->w[i]; e->h = w->h[i];
+        e->kind = w->kind[i]; e->flags = w->flags[i];
+        AnimFrame f = AnimSource(w->anim[i], w->animFrame[i]);
+        e->frameX = f.x; e->frameY = f.y;
+    }
+    snap->numEntities = n;
+    CopyParticles(&snap->particles, r->particles);
+}
+
+static void LatchedInput(SimRunner* r, SimInput* in) {
+    int held = SDL_AtomicGet(&r->held);
+    *in = (SimInput){
+        (held & INPUT_LEFT) != 0, (held & INPUT_RIGHT) != 0, (held & INPUT_UP) != 0, (held & INPUT_DOWN) != 0,
+        (held & INPUT_JUMP_HELD) != 0,
+        false, false, false
+    };
+    if (SDL_AtomicGet(&r->jumpPresses) != r->seenJump) { in->jumpPressed = true; r->seenJump++; }
+    if (SDL_AtomicGet(&r->attackPresses) != r->seenAttack) { in->attackPressed = true; r->seenAttack++; }
+    if (SDL_AtomicGet(&r->dashPresses) != r->seenDash) { in->dashPressed = true; r->seenDash++; }
+}
+
+static int SimThread(void* data) {
+    SimRunner* r = data;
+    Uint64 freq = SDL_GetPerformanceFrequency();
+    Uint64 step = (Uint64)(r->dt * (double)freq);
+    Uint64 maxLag = (Uint64)(SIM_MAX_LAG * (double)freq);
+    Uint64 next = SDL_GetPerformanceCounter();
+
+    while (!SDL_AtomicGet(&r->quit)) {
+        Uint64 now = SDL_GetPerformanceCounter();
+        if (!r->uncapped) {
+            if (now < next) {
+                Uint32 ms = (Uint32)((next - now) * 1000 / freq);
+                SDL_Delay(ms > 1 ? ms - 1 : 0);
+                continue;
+            }
+            if (now - next > maxLag) next = now;
+        }
+
+        SimInput in;
+        LatchedInput(r, &in);
+        if (!NextTickInput(r, &in)) break;
+        RunnerTick(r, &in, false);
+        next += step;
+
+        CaptureSnapshot(r, r->snapshots[r->back]);
+        r->back = SDL_AtomicSet(&r->middle, r->back | SNAP_FRESH) & 3;
+    }
+    SDL_AtomicSet(&r->finished, 1);
+    return 0;
+}
+
+bool StartSimThread(SimRunner* r, bool uncapped) {
+    for (int i = 0; i < 3; i++) {
+        r->snapshots[i] = malloc(sizeof(RenderSnapshot));
+        if (!r->snapshots[i]) return false;
+    }
+    r->uncapped = uncapped;
+    int middle = SDL_AtomicGet(&r->middle) & 3;
+    CaptureSnapshot(r, r->snapshots[middle]);
+    SDL_AtomicSet(&r->middle, middle | SNAP_FRESH);
+    r->thread = SDL_CreateThread(SimThread, "sim", r);
+    return r->thread != NULL;
+}
+
+void StopSimThread(SimRunner* r) {
+    if (r->thread) {
+        SDL_AtomicSet(&r->quit, 1);
+        SDL_WaitThread(r->thread, NULL);
+        r->thread = NULL;
+    }
+    for (int i = 0; i < 3; i++) {
+        free(r->snapshots[i]);
+        r->snapshots[i] = NULL;
+    }
+}
+
+void PublishInput(SimRunner* r, const SimInput* in) {
+    int held = (in->left ? INPUT_LEFT : 0) | (in->right ? INPUT_RIGHT : 0) |
+               (in->up ? INPUT_UP : 0) | (in->down ? INPUT_DOWN : 0) |
+               (in->jumpHeld ? INPUT_JUMP_HELD : 0);
+    SDL_AtomicSet(&r->held, held);
+    if (in->jumpPressed) SDL_AtomicAdd(&r->jumpPresses, 1);
+    if (in->attackPressed) SDL_AtomicAdd(&r->attackPresses, 1);
+    if (in->dashPressed) SDL_AtomicAdd(&r->dashPresses, 1);
+}
+
+const RenderSnapshot* AcquireSnapshot(SimRunner* r) {
+    if (SDL_AtomicGet(&r->middle) & SNAP_FRESH) r->front = SDL_AtomicSet(&r->middle, r->front) & 3;
+    return r->snapshots[r->front];
+}
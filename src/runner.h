@@ -0,0 +1,94 @@
+#ifndef RUNNER_H
+#define RUNNER_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+#include "audio.h"
+#include "camera.h"
+#include "jobs.h"
+#include "latency.h"
+#include "particles.h"
+#include "replay.h"
+#include "rollback.h"
+#include "sim.h"
+#include "world.h"
+
+#define SNAP_MAX_ENTITIES 4096
+#define SNAP_FRESH 4
+#define SIM_MAX_LAG 0.25
+
+enum {
+    INPUT_LEFT      = 1 << 0,
+    INPUT_RIGHT     = 1 << 1,
+    INPUT_UP        = 1 << 2,
+    INPUT_DOWN      = 1 << 3,
+    INPUT_JUMP_HELD = 1 << 4
+};
+
+typedef struct {
+    float x, y, prevX, prevY;
+    float w, h;
+    uint8_t kind, flags;
+    int16_t frameX, frameY;
+} SnapEntity;
+
+typedef struct {
+    uint64_t tick;
+    Uint64 publishPerf;
+    Player player;
+    float globalTimer;
+    SimInput input;
+    uint32_t responses[PROBE_COUNT];
+    Camera camera;
+    int numEntities;
+    SnapEntity entities[SNAP_MAX_ENTITIES];
+    ParticlePool particles;
+} RenderSnapshot;
+
+typedef struct {
+    const Level* level;
+    JobSystem* jobs;
+    World* world;
+    ParticlePool* particles;
+    SfxMixer* sfx;
+    Replay* replay;
+    Replay* recording;
+    RollbackSession* rollback;
+    LoopbackTransport* transport;
+    uint64_t inputTick;
+    float dt;
+
+    SimState sim;
+    SimInput lastInput;
+    uint32_t responses[PROBE_COUNT];
+    Camera camera;
+    SDL_atomic_t viewW, viewH;
+    int scratch[SNAP_MAX_ENTITIES];
+
+    SDL_Thread* thread;
+    SDL_atomic_t quit;
+    SDL_atomic_t finished;
+    bool uncapped;
+
+    SDL_atomic_t held;
+    SDL_atomic_t jumpPresses, attackPresses, dashPresses;
+    int seenJump, seenAttack, seenDash;
+
+    RenderSnapshot* snapshots[3];
+    SDL_atomic_t middle;
+    int back, front;
+} SimRunner;
+
+void InitRunner(SimRunner* r, const Level* level, World* world, ParticlePool* particles, JobSystem* jobs, float dt);
+void SetRunnerView(SimRunner* r, int w, int h);
+bool NextTickInput(SimRunner* r, SimInput* in);
+void RunnerTick(SimRunner* r, const SimInput* in, bool profile);
+void CaptureSnapshot(SimRunner* r, RenderSnapshot* snap);
+
+bool StartSimThread(SimRunner* r, bool uncapped);
+void StopSimThread(SimRunner* r);
+void PublishInput(SimRunner* r, const SimInput* in);
+const RenderSnapshot* AcquireSnapshot(SimRunner* r);
+
+#endif
@@ -0,0 +1,247 @@
+#include "sim.h"
+#include "anim.h"
+#include <math.h>
+#include <string.h>
+
+const MoveParams defaultMoveParams = {
+    GRAVITY, JUMP_FORCE, MAX_SPEED,
+    ACCEL_GROUND, FRICTION_GROUND,
+    ACCEL_AIR, FRICTION_AIR,
+    DASH_SPEED, DASH_DURATION, DASH_COOLDOWN
+};
+
+float Lerp(float a, float b, float t) {
+    return a + (b - a) * t;
+}
+
+float RunVelocity(const MoveParams* m, float vx, float dir, bool onGround, float dt) {
+    float targetSpeed = dir * m->maxSpeed;
+    float accel = onGround ? m->accelGround : m->accelAir;
+    float friction = onGround ? m->frictionGround : m->frictionAir;
+
+    if (dir != 0) {
+        if (vx * dir < 0) vx = Lerp(vx, targetSpeed, 10.0f * dt);
+        else {
+            if (dir > 0 && vx < targetSpeed) vx += accel * dt;
+            else if (dir < 0 && vx > targetSpeed) vx -= accel * dt;
+        }
+    } else {
+        if (vx > 0) {
+            vx -= friction * dt;
+            if (vx < 0) vx = 0;
+        } else if (vx < 0) {
+            vx += friction * dt;
+            if (vx > 0) vx = 0;
+        }
+    }
+
+    if (vx > m->maxSpeed) vx = m->maxSpeed;
+    if (vx < -m->maxSpeed) vx = -m->maxSpeed;
+    return vx;
+}
+
+void Respawn(Player* p) {
+    p->x = p->startX;
+    p->y = p->startY;
+    p->prevX = p->x; p->prevY = p->y;
+    p->vx = 0; p->vy = 0;
+    p->idleDeathTimer = IDLE_DEATH_TIME;
+    p->scaleX = 0.1f; p->scaleY = 2.0f;
+}
+
+void SimInit(SimState* s, const Level* level) {
+    *s = (SimState){0};
+    s->params = defaultMoveParams;
+    Player* p = &s->player;
+    p->x = p->prevX = p->startX = level->spawnX;
+    p->y = p->prevY = p->startY = level->spawnY;
+    p->facingRight = true;
+    p->frameX = ARMED_OFFSET_X; p->frameY = 40;
+    p->idleDeathTimer = IDLE_DEATH_TIME;
+    p->scaleX = 1.0f; p->scaleY = 1.0f;
+}
+
+static void UpdatePlayer(SimState* s, const SimInput* in, float dt) {
+    Player* p = &s->player;
+    const MoveParams* m = &s->params;
+
+    p->scaleX = Lerp(p->scaleX, 1.0f, 15.0f * dt);
+    p->scaleY = Lerp(p->scaleY, 1.0f, 15.0f * dt);
+
+    if (p->coyoteTimer > 0) p->coyoteTimer -= dt;
+    if (p->jumpBufferTimer > 0) p->jumpBufferTimer -= dt;
+    if (p->dashCooldownTimer > 0) p->dashCooldownTimer -= dt;
+    if (p->dashTimer > 0) p->dashTimer -= dt;
+    if (p->dashTimer <= 0) p->isDashing = false;
+
+    bool isMoving = (fabs(p->vx) > 10.0f) || p->isDashing || p->isAttacking || !p->onGround;
+    if (isMoving) p->idleDeathTimer = IDLE_DEATH_TIME;
+    else {
+        p->idleDeathTimer -= dt;
+        if (p->idleDeathTimer <= 0) Respawn(p);
+    }
+
+    if (in->attackPressed && !p->isDashing && !p->isAttacking) {
+        p->isAttacking = true;
+        p->state = 4; p->animFrame = 0; p->animTimer = 0;
+        p->vx = 0; 
+        s->events |= SIM_EV_ATTACK;
+    }
+
+    if (in->dashPressed && p->dashCooldownTimer <= 0 && !p->isAttacking) {
+        p->isDashing = true;
+        p->dashTimer = m->dashDuration;
+        p->dashCooldownTimer = m->dashCooldown;
+        p->vx = (p->facingRight ? 1 : -1) * m->dashSpeed;
+        p->vy = 0; 
+        p->state = 3;
+        p->scaleX = 1.4f; p->scaleY = 0.6f;
+        s->events |= SIM_EV_DASH;
+    }
+
+    bool jumpRequested = in->jumpPressed;
+
+    if (in->up && p->onGround && p->jumpBufferTimer <= 0) {
+        jumpRequested = true;
+    }
+    if (jumpRequested) p->jumpBufferTimer = 0.1f;
+
+    bool isJumpHeld = in->jumpHeld || in->up;
+
+    if (p->isAttacking) {
+        p->vx = Lerp(p->vx, 0, 10.0f * dt);
+        p->vy += m->gravity * dt;
+    }
+    else if (p->isDashing) {
+        p->vx = (p->facingRight ? 1 : -1) * m->dashSpeed;
+        p->vy = 0;
+        s->events |= SIM_EV_DASH_TRAIL;
+    } 
+    else {
+
+        float dir = 0.0f;
+        if (in->left) dir -= 1.0f;
+        if (in->right) dir += 1.0f;
+        if (in->left && in->right) dir = 0.0f;
+
+        p->vx = RunVelocity(m, p->vx, dir, p->onGround, dt);
+        if (dir != 0) p->facingRight = (dir > 0);
+
+        if (p->jumpBufferTimer > 0 && p->coyoteTimer > 0) {
+            p->vy = m->jumpForce;
+            p->onGround = false;
+            p->coyoteTimer = 0; p->jumpBufferTimer = 0;
+            p->scaleX = 0.7f; p->scaleY = 1.3f; 
+            s->events |= SIM_EV_JUMP;
+        }
+
+        if (p->vy < -200.0f && !isJumpHeld) {
+            p->vy *= 0.6f; 
+
+        }
+
+        if (!p->onGround) p->state = 2; 
+        else if (fabs(p->vx) > 20) p->state = 1; 
+        else p->state = 0; 
+
+        p->vy += m->gravity * dt;
+    }
+
+    p->x += p->vx * dt;
+    p->y += p->vy * dt;
+}
+
+static void ResolveCollision(SimState* s, const Level* level) {
+    Player* p = &s->player;
+
+    float feetY = p->y + DRAW_SIZE - SPRITE_OFFSET_Y;
+    RectF pRect = { p->x + DRAW_SIZE/2 - 10, feetY - 40, 20, 40 };
+    bool wasOnGround = p->onGround;
+    p->onGround = false;
+
+    int contacts[MAX_CONTACTS];
+    int numContacts = LevelQuery(level, pRect, contacts, MAX_CONTACTS);
+
+    const RectF* ground = NULL;
+    for (int i = 0; i < numContacts; i++) {
+        const RectF* w = &level->rects[contacts[i]];
+        float penetration = (pRect.y + pRect.h) - w->y;
+        if (p->vy >= 0 && penetration < 50.0f && (!ground || w->y < ground->y)) ground = w;
+    }
+
+    if (ground) {
+        p->y = ground->y - (DRAW_SIZE - SPRITE_OFFSET_Y);
+        p->vy = 0;
+        p->onGround = true;
+        p->coyoteTimer = 0.1f;
+        if (!wasOnGround) { p->scaleX = 1.3f; p->scaleY = 0.7f; s->events |= SIM_EV_LAND; }
+    } else if (numContacts == 0 && wasOnGround && p->vy >= 0 && !p->isDashing) {
+        p->coyoteTimer = 0.1f;
+    }
+}
+
+static int PlayerClip(const Player* p) {
+    if (p->isDashing) return ANIM_DASH;
+    if (p->isAttacking) return ANIM_ATTACK;
+    if (p->state == 1) return ANIM_RUN;
+    if (p->state == 2) return p->vy < -400 ? ANIM_RISE : (p->vy > 400 ? ANIM_FALL : ANIM_AIR);
+    return ANIM_IDLE;
+}
+
+static void SelectAnimFrame(Player* p, float dt) {
+    PlayAnim(&p->anim, &p->animFrame, &p->animTimer, PlayerClip(p));
+    AdvanceAnims(&p->anim, &p->animFrame, &p->animTimer, 1, dt);
+    if (p->isAttacking && AnimFinished(p->anim, p->animFrame)) { p->isAttacking = false; p->state = 0; }
+
+    AnimFrame f = AnimSource(p->anim, p->animFrame);
+    p->frameX = f.x; p->frameY = f.y;
+}
+
+void SimStep(SimState* s, const Level* level, const SimInput* in, float dt) {
+    Player* p = &s->player;
+    s->globalTimer += dt;
+    s->tick++;
+
+    s->events = 0;
+
+    p->prevX = p->x; p->prevY = p->y;
+
+    UpdatePlayer(s, in, dt);
+    ResolveCollision(s, level);
+    if (p->y > 600) Respawn(p);
+    SelectAnimFrame(p, dt);
+}
+
+static uint64_t HashBytes(uint64_t h, const void* data, size_t len) {
+    const unsigned char* b = data;
+    for (size_t i = 0; i < len; i++) { h ^= b[i]; h *= 0x100000001B3ull; }
+    return h;
+}
+
+static uint64_t HashFloat(uint64_t h, float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return HashBytes(h, &bits, sizeof(bits));
+}
+
+static uint64_t HashInt(uint64_t h, int32_t v) {
+    return HashBytes(h, &v, sizeof(v));
+}
+
+uint64_t SimHash(const SimState* s) {
+    const Player* p = &s->player;
+    uint64_t h = 0xCBF29CE484222325ull;
+    h = HashBytes(h, &s->tick, sizeof(s->tick));
+    h = HashFloat(h, s->globalTimer);
+    h = HashFloat(h, p->x); h = HashFloat(h, p->y);
+    h = HashFloat(h, p->vx); h = HashFloat(h, p->vy);
+    h = HashFloat(h, p->animTimer);
+    h = HashFloat(h, p->coyoteTimer); h = HashFloat(h, p->jumpBufferTimer);
+    h = HashFloat(h, p->dashTimer); h = HashFloat(h, p->dashCooldownTimer);
+    h = HashFloat(h, p->idleDeathTimer);
+    h = HashFloat(h, p->scaleX); h = HashFloat(h, p->scaleY);
+    h = HashInt(h, p->state); h = HashInt(h, p->anim); h = HashInt(h, p->animFrame);
+    h = HashInt(h, p->frameX); h = HashInt(h, p->frameY);
+    h = HashInt(h, (p->facingRight << 0) | (p->onGround << 1) | (p->isDashing << 2) | (p->isAttacking << 3));
+    return h;
+}
@@ -0,0 +1,99 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "level.h"
+
+#define GRAVITY 3200.0f
+#define JUMP_FORCE -960.0f
+#define MAX_SPEED 300.0f
+#define ACCEL_GROUND 2500.0f
+#define FRICTION_GROUND 1800.0f
+#define ACCEL_AIR 1500.0f
+#define FRICTION_AIR 500.0f
+
+#define DASH_SPEED 1000.0f
+#define DASH_DURATION 0.15f
+#define DASH_COOLDOWN 0.6f
+#define IDLE_DEATH_TIME 1.5f
+
+#define SPRITE_SIZE 20
+#define DRAW_SIZE 80  
+#define SPRITE_OFFSET_Y 10
+#define ARMED_OFFSET_X 100
+
+#define MAX_CONTACTS 16
+
+enum {
+    SIM_EV_JUMP       = 1 << 0,
+    SIM_EV_LAND       = 1 << 1,
+    SIM_EV_DASH       = 1 << 2,
+    SIM_EV_DASH_TRAIL = 1 << 3,
+    SIM_EV_ATTACK     = 1 << 4
+};
+
+typedef struct {
+    float gravity;
+    float jumpForce;
+    float maxSpeed;
+    float accelGround, frictionGround;
+    float accelAir, frictionAir;
+    float dashSpeed, dashDuration, dashCooldown;
+} MoveParams;
+
+typedef struct {
+    float x, y;
+    float prevX, prevY;
+    float startX, startY;
+    float vx, vy;
+    bool facingRight;
+
+    float animTimer;
+    uint8_t anim;
+    uint8_t animFrame;
+    int state; 
+
+    int frameX, frameY;
+
+    bool onGround;
+    float coyoteTimer;
+    float jumpBufferTimer;
+
+    float dashTimer;
+    float dashCooldownTimer;
+    bool isDashing;
+    bool isAttacking;
+    float idleDeathTimer;
+
+    float scaleX, scaleY;
+} Player;
+
+typedef struct {
+    bool left, right, up, down;
+    bool jumpHeld;
+    bool jumpPressed;
+    bool attackPressed;
+    bool dashPressed;
+} SimInput;
+
+typedef struct {
+    Player player;
+    uint32_t events;
+    float globalTimer;
+    uint64_t tick;
+    MoveParams params;
+} SimState;
+
+extern const MoveParams defaultMoveParams;
+
+float Lerp(float a, float b, float t);
+float RunVelocity(const MoveParams* m, float vx, float dir, bool onGround, float dt);
+
+void SimInit(SimState* s, const Level* level);
+void SimStep(SimState* s, const Level* level, const SimInput* in, float dt);
+void Respawn(Player* p);
+uint64_t SimHash(const SimState* s);
+
+#endif
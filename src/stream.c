@@ -0,0 +1,93 @@
+#include "stream.h"
+#include <math.h>
+#include <stdlib.h>
+
+static void FillChunk(ChunkStreamer* s, Chunk* c) {
+    RectF area = { (float)c->cx * CHUNK_SIZE, (float)c->cy * CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE };
+    int n = LevelQuery(s->level, area, s->scratch, CHUNK_MAX_TILES);
+    c->numTiles = 0;
+    for (int i = 0; i < n; i++) {
+        const RectF* r = &s->level->rects[s->scratch[i]];
+        float x0 = fmaxf(r->x, area.x), x1 = fminf(r->x + r->w, area.x + area.w);
+        float y0 = fmaxf(r->y, area.y), y1 = fminf(r->y + r->h, area.y + area.h);
+        if (x1 <= x0 || y1 <= y0) continue;
+        c->tiles[c->numTiles++] = (RectF){ x0, y0, x1 - x0, y1 - y0 };
+    }
+}
+
+static int StreamThread(void* data) {
+    ChunkStreamer* s = data;
+    for (;;) {
+        SDL_SemWait(s->wake);
+        if (SDL_AtomicGet(&s->quit)) break;
+        while (SDL_AtomicGet(&s->tail) != SDL_AtomicGet(&s->head)) {
+            int slot = s->queue[SDL_AtomicGet(&s->tail) % STREAM_SLOTS];
+            FillChunk(s, &s->chunks[slot]);
+            SDL_AtomicSet(&s->chunks[slot].state, CHUNK_READY);
+            SDL_AtomicAdd(&s->tail, 1);
+        }
+    }
+    return 0;
+}
+
+ChunkStreamer* CreateChunkStreamer(const Level* level) {
+    ChunkStreamer* s = calloc(1, sizeof(ChunkStreamer));
+    if (!s) return NULL;
+    s->level = level;
+    s->wake = SDL_CreateSemaphore(0);
+    if (s->wake) s->thread = SDL_CreateThread(StreamThread, "stream", s);
+    if (!s->thread) {
+        DestroyChunkStreamer(s);
+        return NULL;
+    }
+    return s;
+}
+
+void DestroyChunkStreamer(ChunkStreamer* s) {
+    if (!s) return;
+    if (s->thread) {
+        SDL_AtomicSet(&s->quit, 1);
+        SDL_SemPost(s->wake);
+        SDL_WaitThread(s->thread, NULL);
+    }
+    if (s->wake) SDL_DestroySemaphore(s->wake);
+    free(s);
+}
+
+static void RequestChunk(ChunkStreamer* s, int cx, int cy) {
+    Chunk* victim = NULL;
+    for (int i = 0; i < STREAM_SLOTS; i++) {
+        Chunk* c = &s->chunks[i];
+        int state = SDL_AtomicGet(&c->state);
+        if (state != CHUNK_FREE && c->cx == cx && c->cy == cy) {
+            c->lastUsed = s->frame;
+            return;
+        }
+        if (state == CHUNK_FREE) {
+            if (!victim || SDL_AtomicGet(&victim->state) != CHUNK_FREE) victim = c;
+        } else if (state == CHUNK_READY && c->lastUsed != s->frame) {
+            if (!victim || (SDL_AtomicGet(&victim->state) == CHUNK_READY && c->lastUsed < victim->lastUsed)) victim = c;
+        }
+    }
+    if (!victim) return;
+
+    victim->cx = cx; victim->cy = cy;
+    victim->lastUsed = s->frame;
+    victim->numTiles = 0;
+    SDL_AtomicSet(&victim->state, CHUNK_QUEUED);
+    int head = SDL_AtomicGet(&s->head);
+    s->queue[head % STREAM_SLOTS] = (int)(victim - s->chunks);
+    SDL_AtomicSet(&s->head, head + 1);
+    SDL_SemPost(s->wake);
+}
+
+void StreamAround(ChunkStreamer* s, RectF view) {
+    s->frame++;
+    int cx0 = (int)floorf((view.x - STREAM_MARGIN) / CHUNK_SIZE);
+    int cx1 = (int)floorf((view.x + view.w + STREAM_MARGIN) / CHUNK_SIZE);
+    int cy0 = (int)floorf((view.y - STREAM_MARGIN) / CHUNK_SIZE);
+    int cy1 = (int)floorf((view.y + view.h + STREAM_MARGIN) / CHUNK_SIZE);
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) RequestChunk(s, cx, cy);
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <SDL2/SDL.h>
+
+#include "level.h"
+
+#define CHUNK_SIZE 512
+#define CHUNK_MAX_TILES 1024
+#define STREAM_SLOTS 32
+#define STREAM_MARGIN 256.0f
+
+enum {
+    CHUNK_FREE,
+    CHUNK_QUEUED,
+    CHUNK_READY
+};
+
+typedef struct {
+    SDL_atomic_t state;
+    int cx, cy;
+    uint32_t lastUsed;
+    int numTiles;
+    RectF tiles[CHUNK_MAX_TILES];
+} Chunk;
+
+typedef struct {
+    const Level* level;
+    SDL_Thread* thread;
+    SDL_sem* wake;
+    SDL_atomic_t quit;
+
+    SDL_atomic_t head, tail;
+    int queue[STREAM_SLOTS];
+
+    uint32_t frame;
+    Chunk chunks[STREAM_SLOTS];
+    int scratch[CHUNK_MAX_TILES];
+} ChunkStreamer;
+
+ChunkStreamer* CreateChunkStreamer(const Level* level);
+void DestroyChunkStreamer(ChunkStreamer* s);
+void StreamAround(ChunkStreamer* s, RectF view);
+
+#endif
@@ -0,0 +1,162 @@
+#include "text.h"
+#include <string.h>
+
+#define ATLAS_WIDTH 512
+#define ATLAS_PADDING 1
+
+GlyphAtlas* BuildGlyphAtlas(TTF_Font* font) {
+    if (!font) return NULL;
+
+    GlyphAtlas* atlas = SDL_calloc(1, sizeof(GlyphAtlas));
+    if (!atlas) return NULL;
+    atlas->lineHeight = TTF_FontHeight(font);
+
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface* surfs[GLYPH_COUNT];
+    int penX = ATLAS_PADDING, penY = ATLAS_PADDING, rowH = 0;
+
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        Uint16 ch = (Uint16)(GLYPH_FIRST + i);
+        Glyph* g = &atlas->glyphs[i];
+        int minx, maxx, miny, maxy;
+        if (TTF_GlyphMetrics(font, ch, &minx, &maxx, &miny, &maxy, &g->advance) != 0) g->advance = 0;
+
+        surfs[i] = (ch == ' ') ? NULL : TTF_RenderGlyph_Solid(font, ch, white);
+        if (!surfs[i]) continue;
+
+        if (penX + surfs[i]->w + ATLAS_PADDING > ATLAS_WIDTH) {
+            penX = ATLAS_PADDING;
+            penY += rowH + ATLAS_PADDING;
+            rowH = 0;
+        }
+        g->src = (SDL_Rect){ penX, penY, surfs[i]->w, surfs[i]->h };
+        penX += surfs[i]->w + ATLAS_PADDING;
+        if (surfs[i]->h > rowH) rowH = surfs[i]->h;
+    }
+
+    atlas->texW = ATLAS_WIDTH;
+    atlas->texH = penY + rowH + ATLAS_PADDING;
+
+    SDL_Surface* sheet = SDL_CreateRGBSurfaceWithFormat(0, atlas->texW, atlas->texH, 32, SDL_PIXELFORMAT_RGBA32);
+    atlas->sheet = sheet;
+    if (sheet) {
+        SDL_FillRect(sheet, NULL, SDL_MapRGBA(sheet->format, 0, 0, 0, 0));
+        for (int i = 0; i < GLYPH_COUNT; i++) {
+            if (!surfs[i]) continue;
+            SDL_Rect dst = atlas->glyphs[i].src;
+            SDL_BlitSurface(surfs[i], NULL, sheet, &dst);
+        }
+    }
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        if (surfs[i]) SDL_FreeSurface(surfs[i]);
+    }
+
+    if (!atlas->sheet) {
+        SDL_free(atlas);
+        return NULL;
+    }
+
+    for (int q = 0; q < TEXT_MAX_CHARS; q++) {
+        int* idx = &atlas->indices[q * 6];
+        int v = q * 4;
+        idx[0] = v; idx[1] = v + 1; idx[2] = v + 2;
+        idx[3] = v + 2; idx[4] = v + 3; idx[5] = v;
+    }
+    return atlas;
+}
+
+bool UploadGlyphAtlas(GlyphAtlas* atlas, SDL_Renderer* r) {
+    if (atlas->tex) return true;
+    atlas->tex = SDL_CreateTextureFromSurface(r, atlas->sheet);
+    if (!atlas->tex) return false;
+    SDL_SetTextureBlendMode(atlas->tex, SDL_BLENDMODE_BLEND);
+    SDL_FreeSurface(atlas->sheet);
+    atlas->sheet = NULL;
+    return true;
+}
+
+GlyphAtlas* CreateGlyphAtlas(SDL_Renderer* r, TTF_Font* font) {
+    GlyphAtlas* atlas = BuildGlyphAtlas(font);
+    if (atlas && !UploadGlyphAtlas(atlas, r)) {
+        DestroyGlyphAtlas(atlas);
+        return NULL;
+    }
+    return atlas;
+}
+
+void DestroyGlyphAtlas(GlyphAtlas* atlas) {
+    if (!atlas) return;
+    if (atlas->sheet) SDL_FreeSurface(atlas->sheet);
+    if (atlas->tex) SDL_DestroyTexture(atlas->tex);
+    SDL_free(atlas);
+}
+
+static const Glyph* LookupGlyph(const GlyphAtlas* atlas, char c) {
+    unsigned char uc = (unsigned char)c;
+    if (uc < GLYPH_FIRST || uc > GLYPH_LAST) uc = '?';
+    return &atlas->glyphs[uc - GLYPH_FIRST];
+}
+
+int MeasureText(const GlyphAtlas* atlas, const char* text) {
+    int w = 0;
+    for (int i = 0; text[i] && i < TEXT_MAX_CHARS - 1; i++) w += LookupGlyph(atlas, text[i])->advance;
+    return w;
+}
+
+static void LayoutText(const GlyphAtlas* atlas, TextCacheEntry* e) {
+    float penX = (float)(e->alignRight ? e->x - MeasureText(atlas, e->text) : e->x);
+    float y = (float)e->y;
+    float invW = 1.0f / atlas->texW;
+    float invH = 1.0f / atlas->texH;
+
+    e->numVerts = 0;
+    for (int i = 0; e->text[i]; i++) {
+        const Glyph* g = LookupGlyph(atlas, e->text[i]);
+        if (g->src.w > 0) {
+            SDL_Vertex* v = &e->verts[e->numVerts];
+            float x0 = penX, y0 = y, x1 = penX + g->src.w, y1 = y + g->src.h;
+            float u0 = g->src.x * invW, v0 = g->src.y * invH;
+            float u1 = (g->src.x + g->src.w) * invW, v1 = (g->src.y + g->src.h) * invH;
+            v[0] = (SDL_Vertex){ e->color, { x0, y0 }, { u0, v0 } };
+            v[1] = (SDL_Vertex){ e->color, { x1, y0 }, { u1, v0 } };
+            v[2] = (SDL_Vertex){ e->color, { x1, y1 }, { u1, v1 } };
+            v[3] = (SDL_Vertex){ e->color, { x0, y1 }, { u0, v1 } };
+            e->numVerts += 4;
+        }
+        penX += g->advance;
+    }
+}
+
+static bool SameColor(SDL_Color a, SDL_Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+static TextCacheEntry* FetchText(GlyphAtlas* atlas, const char* text, int x, int y, SDL_Color color, bool alignRight) {
+    TextCacheEntry* oldest = &atlas->cache[0];
+    atlas->useCounter++;
+
+    for (int i = 0; i < TEXT_CACHE_SLOTS; i++) {
+        TextCacheEntry* e = &atlas->cache[i];
+        if (e->lastUsed && e->x == x && e->y == y && e->alignRight == alignRight &&
+            SameColor(e->color, color) && strncmp(e->text, text, TEXT_MAX_CHARS - 1) == 0) {
+            e->lastUsed = atlas->useCounter;
+            return e;
+        }
+        if (e->lastUsed < oldest->lastUsed) oldest = e;
+    }
+
+    SDL_strlcpy(oldest->text, text, TEXT_MAX_CHARS);
+    oldest->x = x; oldest->y = y;
+    oldest->color = color;
+    oldest->alignRight = alignRight;
+    oldest->lastUsed = atlas->useCounter;
+    LayoutText(atlas, oldest);
+    return oldest;
+}
+
+void RenderText(SDL_Renderer* r, GlyphAtlas* atlas, const char* text, int x, int y, SDL_Color color, bool alignRight) {
+    if (!atlas || !atlas->tex || !text) return;
+    TextCacheEntry* e = FetchText(atlas, text, x, y, color, alignRight);
+    if (e->numVerts == 0) return;
+    SDL_RenderGeometry(r, atlas->tex, e->verts, e->numVerts, atlas->indices, (e->numVerts / 4) * 6);
+}
@@ -0,0 +1,48 @@
+#ifndef TEXT_H
+#define TEXT_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+
+#define GLYPH_FIRST 32
+#define GLYPH_LAST 126
+#define GLYPH_COUNT (GLYPH_LAST - GLYPH_FIRST + 1)
+
+#define TEXT_MAX_CHARS 64
+#define TEXT_CACHE_SLOTS 16
+
+typedef struct {
+    SDL_Rect src;
+    int advance;
+} Glyph;
+
+typedef struct {
+    char text[TEXT_MAX_CHARS];
+    int x, y;
+    SDL_Color color;
+    bool alignRight;
+    int numVerts;
+    unsigned int lastUsed;
+    SDL_Vertex verts[TEXT_MAX_CHARS * 4];
+} TextCacheEntry;
+
+typedef struct {
+    SDL_Texture* tex;
+    SDL_Surface* sheet;
+    int texW, texH;
+    int lineHeight;
+    Glyph glyphs[GLYPH_COUNT];
+    int indices[TEXT_MAX_CHARS * 6];
+    unsigned int useCounter;
+    TextCacheEntry cache[TEXT_CACHE_SLOTS];
+} GlyphAtlas;
+
+GlyphAtlas* BuildGlyphAtlas(TTF_Font* font);
+bool UploadGlyphAtlas(GlyphAtlas* atlas, SDL_Renderer* r);
+GlyphAtlas* CreateGlyphAtlas(SDL_Renderer* r, TTF_Font* font);
+void DestroyGlyphAtlas(GlyphAtlas* atlas);
+int MeasureText(const GlyphAtlas* atlas, const char* text);
+void RenderText(SDL_Renderer* r, GlyphAtlas* atlas, const char* text, int x, int y, SDL_Color color, bool alignRight);
+
+#endif
@@ -0,0 +1,130 @@
+#include "tuning.h"
+#include <math.h>
+#include <stdio.h>
+
+const TuneScript tuneScripts[] = {
+    { "run", 240, 1, { { 0, 240, TUNE_RIGHT } } },
+    { "jump", 240, 1, { { 0, 40, TUNE_JUMP } } },
+    { "dash", 120, 1, { { 0, 1, TUNE_DASH } } },
+    { "run_jump_dash", 360, 3, { { 0, 360, TUNE_RIGHT }, { 60, 40, TUNE_JUMP }, { 150, 1, TUNE_DASH } } },
+};
+const int numTuneScripts = (int)(sizeof(tuneScripts) / sizeof(tuneScripts[0]));
+
+static uint32_t NextRandom(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    return *state = x;
+}
+
+static float Jitter(float value, float spread, uint32_t* rng) {
+    float u = (float)(NextRandom(rng) & 0xFFFFFF) / (float)0xFFFFFF;
+    return value * (1.0f + spread * (u * 2.0f - 1.0f));
+}
+
+void GenerateMoveParams(MoveParams* out, int count, float spread, uint32_t seed) {
+    uint32_t rng = seed ? seed : 0x9E3779B9u;
+    const MoveParams* d = &defaultMoveParams;
+    for (int i = 0; i < count; i++) {
+        if (i == 0) { out[i] = *d; continue; }
+        MoveParams* m = &out[i];
+        m->gravity = Jitter(d->gravity, spread, &rng);
+        m->jumpForce = Jitter(d->jumpForce, spread, &rng);
+        m->maxSpeed = Jitter(d->maxSpeed, spread, &rng);
+        m->accelGround = Jitter(d->accelGround, spread, &rng);
+        m->frictionGround = Jitter(d->frictionGround, spread, &rng);
+        m->accelAir = Jitter(d->accelAir, spread, &rng);
+        m->frictionAir = Jitter(d->frictionAir, spread, &rng);
+        m->dashSpeed = Jitter(d->dashSpeed, spread, &rng);
+        m->dashDuration = Jitter(d->dashDuration, spread, &rng);
+        m->dashCooldown = Jitter(d->dashCooldown, spread, &rng);
+    }
+}
+
+static void ScriptInput(const TuneScript* script, int t, SimInput* in) {
+    *in = (SimInput){0};
+    for (int k = 0; k < script->numSteps; k++) {
+        const TuneStep* step = &script->steps[k];
+        if (t < step->start || t >= step->start + step->length) continue;
+        bool first = t == step->start;
+        if (step->buttons & TUNE_LEFT) in->left = true;
+        if (step->buttons & TUNE_RIGHT) in->right = true;
+        if (step->buttons & TUNE_JUMP) { in->jumpHeld = true; in->jumpPressed |= first; }
+        if (step->buttons & TUNE_DASH) in->dashPressed |= first;
+        if (step->buttons & TUNE_ATTACK) in->attackPressed |= first;
+    }
+}
+
+static void RunTune(const TuneSweep* sweep, const MoveParams* params, const TuneScript* script, TuneResult* out) {
+    SimState s;
+    SimInit(&s, sweep->level);
+    s.params = *params;
+
+    SimInput idle = {0};
+    for (int t = 0; t < TUNE_SETTLE_TICKS && !s.player.onGround; t++) SimStep(&s, sweep->level, &idle, sweep->dt);
+
+    *out = (TuneResult){ 0.0f, 0.0f, -1.0f, -1 };
+    int takeoff = -1;
+    float takeoffY = 0.0f, minY = 0.0f;
+    bool dashing = false, dashDone = false;
+    float dashX = 0.0f;
+
+    for (int t = 0; t < script->ticks; t++) {
+        SimInput in;
+        ScriptInput(script, t, &in);
+        SimStep(&s, sweep->level, &in, sweep->dt);
+        const Player* p = &s.player;
+
+        if (out->timeToMaxSpeed < 0 && !p->isDashing && fabsf(p->vx) >= params->maxSpeed * 0.99f) out->timeToMaxSpeed = (t + 1) * sweep->dt;
+
+        if ((s.events & SIM_EV_JUMP) && takeoff < 0) {
+            takeoff = t;
+            takeoffY = minY = p->prevY;
+        }
+        if (takeoff >= 0 && out->landingTick < 0) {
+            if (p->y < minY) minY = p->y;
+            if (s.events & SIM_EV_LAND) {
+                out->landingTick = t - takeoff;
+                out->jumpApex = takeoffY - minY;
+            }
+        }
+
+        if ((s.events & SIM_EV_DASH) && !dashing && !dashDone) { dashing = true; dashX = p->prevX; }
+        if (dashing && !p->isDashing) {
+            out->dashDistance = fabsf(p->x - dashX);
+            dashing = false;
+            dashDone = true;
+        }
+    }
+    if (takeoff >= 0 && out->landingTick < 0) out->jumpApex = takeoffY - minY;
+}
+
+static void TuneRange(void* ctx, int begin, int end) {
+    const TuneSweep* sweep = ctx;
+    for (int i = begin; i < end; i++) {
+        int set = i / sweep->numScripts;
+        int script = i % sweep->numScripts;
+        RunTune(sweep, &sweep->params[set], &sweep->scripts[script], &sweep->results[i]);
+    }
+}
+
+void RunTuneSweep(TuneSweep* sweep, JobSystem* jobs) {
+    ParallelFor(jobs, sweep->numParams * sweep->numScripts, TUNE_GRAIN, TuneRange, sweep);
+}
+
+bool WriteTuneResults(const TuneSweep* sweep, const char* path) {
+    FILE* f = path ? fopen(path, "w") : stdout;
+    if (!f) return false;
+    fprintf(f, "set,script,gravity,jump_force,max_speed,accel_ground,friction_ground,accel_air,friction_air,"
+               "dash_speed,dash_duration,dash_cooldown,jump_apex,dash_distance,time_to_max_speed,landing_tick\n");
+    for (int i = 0; i < sweep->numParams * sweep->numScripts; i++) {
+        const MoveParams* m = &sweep->params[i / sweep->numScripts];
+        const TuneResult* r = &sweep->results[i];
+        fprintf(f, "%d,%s,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.4f,%.4f,%.2f,%.2f,%.4f,%d\n",
+                i / sweep->numScripts, sweep->scripts[i % sweep->numScripts].name,
+                m->gravity, m->jumpForce, m->maxSpeed, m->accelGround, m->frictionGround,
+                m->accelAir, m->frictionAir, m->dashSpeed, m->dashDuration, m->dashCooldown,
+                r->jumpApex, r->dashDistance, r->timeToMaxSpeed, r->landingTick);
+    }
+    if (f != stdout) fclose(f);
+    return true;
+}
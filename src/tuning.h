@@ -0,0 +1,59 @@
+#ifndef TUNING_H
+#define TUNING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "jobs.h"
+#include "level.h"
+#include "sim.h"
+
+#define TUNE_SETTLE_TICKS 240
+#define TUNE_MAX_STEPS 8
+#define TUNE_GRAIN 16
+
+enum {
+    TUNE_LEFT   = 1 << 0,
+    TUNE_RIGHT  = 1 << 1,
+    TUNE_JUMP   = 1 << 2,
+    TUNE_DASH   = 1 << 3,
+    TUNE_ATTACK = 1 << 4
+};
+
+typedef struct {
+    uint16_t start, length;
+    uint8_t buttons;
+} TuneStep;
+
+typedef struct {
+    const char* name;
+    int ticks;
+    int numSteps;
+    TuneStep steps[TUNE_MAX_STEPS];
+} TuneScript;
+
+typedef struct {
+    float jumpApex;
+    float dashDistance;
+    float timeToMaxSpeed;
+    int landingTick;
+} TuneResult;
+
+typedef struct {
+    const Level* level;
+    float dt;
+    const MoveParams* params;
+    int numParams;
+    const TuneScript* scripts;
+    int numScripts;
+    TuneResult* results;
+} TuneSweep;
+
+extern const TuneScript tuneScripts[];
+extern const int numTuneScripts;
+
+void GenerateMoveParams(MoveParams* out, int count, float spread, uint32_t seed);
+void RunTuneSweep(TuneSweep* sweep, JobSystem* jobs);
+bool WriteTuneResults(const TuneSweep* sweep, const char* path);
+
+#endif
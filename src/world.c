@@ -0,0 +1,408 @@
+#include "world.h"
+#include "anim.h"
+#include "sim.h"
+#include <math.h>
+#include <string.h>
+
+typedef struct {
+    World* w;
+    const Level* level;
+    float dt;
+} StepContext;
+
+static uint32_t NextRandom(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+void ClearWorld(World* w, uint32_t seed) {
+    w->count = 0;
+    w->numMovers = 0;
+    w->seed = seed ? seed : 0x9E3779B9u;
+    w->tick = 0;
+}
+
+static int AddEntity(World* w, int kind, float x, float y, float width, float height) {
+    if (w->count >= MAX_ENTITIES) return -1;
+    int i = w->count++;
+    w->kind[i] = (uint8_t)kind;
+    w->flags[i] = ENT_FACING_RIGHT;
+    w->x[i] = w->prevX[i] = w->startX[i] = x;
+    w->y[i] = w->prevY[i] = w->startY[i] = y;
+    w->vx[i] = 0; w->vy[i] = 0;
+    w->w[i] = width; w->h[i] = height;
+    w->coyoteTimer[i] = 0; w->jumpBufferTimer[i] = 0;
+    w->dashTimer[i] = 0; w->dashCooldownTimer[i] = 0;
+    w->thinkTimer[i] = 0; w->fireTimer[i] = 0;
+    w->dir[i] = 0;
+    w->rng[i] = NextRandom(&w->seed) | 1;
+    w->rangeX[i] = 0; w->rangeY[i] = 0;
+    w->period[i] = 1; w->phase[i] = 0;
+    w->life[i] = 0;
+    w->hit[i] = -1;
+    w->anim[i] = ANIM_IDLE; w->animFrame[i] = 0; w->animTimer[i] = 0;
+    return i;
+}
+
+int SpawnEnemy(World* w, float x, float y) {
+    int i = AddEntity(w, ENT_ENEMY, x, y, ENEMY_W, ENEMY_H);
+    if (i >= 0) w->fireTimer[i] = FIRE_COOLDOWN * (float)(w->rng[i] % 1000) / 1000.0f;
+    return i;
+}
+
+int SpawnMover(World* w, float x, float y, float width, float height, float rangeX, float rangeY, float period) {
+    if (w->numMovers >= MAX_MOVERS) return -1;
+    if (width > MAX_ENTITY_SIZE) width = MAX_ENTITY_SIZE;
+    if (height > MAX_ENTITY_SIZE) height = MAX_ENTITY_SIZE;
+    int i = AddEntity(w, ENT_MOVER, x, y, width, height);
+    if (i < 0) return -1;
+    w->rangeX[i] = rangeX; w->rangeY[i] = rangeY;
+    w->period[i] = period > 0 ? period : 1;
+    w->movers[w->numMovers++] = i;
+    return i;
+}
+
+int SpawnProjectile(World* w, float x, float y, float vx) {
+    int i = AddEntity(w, ENT_PROJECTILE, x, y, PROJECTILE_SIZE, PROJECTILE_SIZE);
+    if (i >= 0) { w->vx[i] = vx; w->life[i] = PROJECTILE_LIFE; }
+    return i;
+}
+
+void PopulateWorld(World* w, const Level* level, int numEnemies) {
+    if (level->numRects == 0) return;
+    for (int n = 0; n < numEnemies; n++) {
+        const RectF* r = &level->rects[NextRandom(&w->seed) % (uint32_t)level->numRects];
+        float x = r->x + (float)(NextRandom(&w->seed) % 1000) / 1000.0f * (r->w - ENEMY_W);
+        if (SpawnEnemy(w, x, r->y - ENEMY_H - 1) < 0) break;
+        if (n % 64 == 63) {
+            const RectF* m = &level->rects[NextRandom(&w->seed) % (uint32_t)level->numRects];
+            SpawnMover(w, m->x, m->y - 120, 96, 16, 160, 0, 3.0f);
+        }
+    }
+}
+
+static void UpdateMover(World* w, int i, float dt) {
+    w->prevX[i] = w->x[i]; w->prevY[i] = w->y[i];
+    w->phase[i] = fmodf(w->phase[i] + dt, w->period[i]);
+    float t = w->phase[i] / w->period[i];
+    float tri = t < 0.5f ? t * 2.0f : 2.0f - t * 2.0f;
+    w->x[i] = w->startX[i] + w->rangeX[i] * tri;
+    w->y[i] = w->startY[i] + w->rangeY[i] * tri;
+}
+
+static void MoverRange(void* ctx, int begin, int end) {
+    StepContext* c = ctx;
+    for (int m = begin; m < end; m++) UpdateMover(c->w, c->w->movers[m], c->dt);
+}
+
+static uint32_t BodyBucket(int cx, int cy) {
+    return ((uint32_t)cx * 73856093u ^ (uint32_t)cy * 19349663u) & (BODY_GRID_BUCKETS - 1);
+}
+
+static void BuildMoverGrid(World* w) {
+    memset(w->moverStart, 0, sizeof(w->moverStart));
+    for (int pass = 0; pass < 2; pass++) {
+        int fill[BODY_GRID_BUCKETS];
+        if (pass == 1) {
+            for (int b = 0; b < BODY_GRID_BUCKETS; b++) w->moverStart[b + 1] += w->moverStart[b];
+            memcpy(fill, w->moverStart, sizeof(fill));
+        }
+        int total = 0;
+        for (int k = 0; k < w->numMovers; k++) {
+            int m = w->movers[k];
+            int x0 = (int)floorf(w->x[m] / BODY_GRID_CELL), x1 = (int)floorf((w->x[m] + w->w[m]) / BODY_GRID_CELL);
+            int y0 = (int)floorf(w->y[m] / BODY_GRID_CELL), y1 = (int)floorf((w->y[m] + w->h[m]) / BODY_GRID_CELL);
+            for (int cy = y0; cy <= y1; cy++) {
+                for (int cx = x0; cx <= x1 && total < MAX_MOVER_CELLS; cx++, total++) {
+                    uint32_t b = BodyBucket(cx, cy);
+                    if (pass == 0) w->moverStart[b + 1]++;
+                    else w->moverItems[fill[b]++] = m;
+                }
+            }
+        }
+    }
+}
+
+static void CollideEnemy(World* w, const Level* level, int i) {
+    RectF box = { w->x[i], w->y[i], w->w[i], w->h[i] };
+    bool wasOnGround = (w->flags[i] & ENT_ON_GROUND) != 0;
+    w->flags[i] &= ~ENT_ON_GROUND;
+
+    int contacts[MAX_CONTACTS];
+    int numContacts = LevelQuery(level, box, contacts, MAX_CONTACTS);
+
+    float groundY = 0;
+    bool hasGround = false;
+    float carryX = 0;
+    if (w->vy[i] >= 0) {
+        for (int k = 0; k < numContacts; k++) {
+            const RectF* r = &level->rects[contacts[k]];
+            float penetration = (box.y + box.h) - r->y;
+            if (penetration < 50.0f && (!hasGround || r->y < groundY)) { groundY = r->y; hasGround = true; }
+        }
+        int x0 = (int)floorf(box.x / BODY_GRID_CELL), x1 = (int)floorf((box.x + box.w) / BODY_GRID_CELL);
+        int y0 = (int)floorf(box.y / BODY_GRID_CELL), y1 = (int)floorf((box.y + box.h) / BODY_GRID_CELL);
+        for (int cy = y0; cy <= y1; cy++) {
+            for (int cx = x0; cx <= x1; cx++) {
+                uint32_t b = BodyBucket(cx, cy);
+                for (int k = w->moverStart[b]; k < w->moverStart[b + 1]; k++) {
+                    int m = w->moverItems[k];
+                    RectF r = { w->x[m], w->y[m], w->w[m], w->h[m] };
+                    if (!checkCol(box, r)) continue;
+                    float penetration = (box.y + box.h) - r.y;
+                    if (penetration < 50.0f && (!hasGround || r.y < groundY)) {
+                        groundY = r.y; hasGround = true;
+                        carryX = w->x[m] - w->prevX[m];
+                    }
+                }
+            }
+        }
+    }
+
+    if (hasGround) {
+        w->x[i] += carryX;
+        w->y[i] = groundY - w->h[i];
+        w->vy[i] = 0;
+        w->flags[i] |= ENT_ON_GROUND;
+        w->coyoteTimer[i] = 0.1f;
+    } else if (numContacts == 0 && wasOnGround && w->vy[i] >= 0 && !(w->flags[i] & ENT_DASHING)) {
+        w->coyoteTimer[i] = 0.1f;
+    }
+}
+
+static void UpdateEnemy(World* w, const Level* level, int i, float dt) {
+    const MoveParams* m = &defaultMoveParams;
+    w->prevX[i] = w->x[i]; w->prevY[i] = w->y[i];
+
+    if (w->coyoteTimer[i] > 0) w->coyoteTimer[i] -= dt;
+    if (w->jumpBufferTimer[i] > 0) w->jumpBufferTimer[i] -= dt;
+    if (w->dashCooldownTimer[i] > 0) w->dashCooldownTimer[i] -= dt;
+    if (w->dashTimer[i] > 0) w->dashTimer[i] -= dt;
+    if (w->dashTimer[i] <= 0) w->flags[i] &= ~ENT_DASHING;
+
+    w->thinkTimer[i] -= dt;
+    if (w->thinkTimer[i] <= 0) {
+        uint32_t r = NextRandom(&w->rng[i]);
+        w->dir[i] = (int8_t)((int)(r % 3) - 1);
+        w->thinkTimer[i] = 0.5f + (float)((r >> 8) & 255) / 255.0f * 1.5f;
+        if (((r >> 16) & 3) == 0) w->jumpBufferTimer[i] = 0.1f;
+        if (((r >> 20) & 7) == 0 && w->dashCooldownTimer[i] <= 0) {
+            w->flags[i] |= ENT_DASHING;
+            w->dashTimer[i] = m->dashDuration;
+            w->dashCooldownTimer[i] = m->dashCooldown;
+        }
+    }
+
+    w->fireTimer[i] -= dt;
+    if (w->fireTimer[i] <= 0) {
+        w->fireTimer[i] = FIRE_COOLDOWN;
+        w->flags[i] |= ENT_FIRE;
+    }
+
+    float facing = (w->flags[i] & ENT_FACING_RIGHT) ? 1.0f : -1.0f;
+    if (w->flags[i] & ENT_DASHING) {
+        w->vx[i] = facing * m->dashSpeed;
+        w->vy[i] = 0;
+    } else {
+        float dir = w->dir[i];
+        w->vx[i] = RunVelocity(m, w->vx[i], dir, (w->flags[i] & ENT_ON_GROUND) != 0, dt);
+        if (dir > 0) w->flags[i] |= ENT_FACING_RIGHT;
+        else if (dir < 0) w->flags[i] &= ~ENT_FACING_RIGHT;
+
+        if (w->jumpBufferTimer[i] > 0 && w->coyoteTimer[i] > 0) {
+            w->vy[i] = m->jumpForce;
+            w->flags[i] &= ~ENT_ON_GROUND;
+            w->coyoteTimer[i] = 0; w->jumpBufferTimer[i] = 0;
+        }
+        w->vy[i] += m->gravity * dt;
+    }
+
+    w->x[i] += w->vx[i] * dt;
+    w->y[i] += w->vy[i] * dt;
+    CollideEnemy(w, level, i);
+
+    if (w->y[i] > 600) {
+        w->x[i] = w->prevX[i] = w->startX[i];
+        w->y[i] = w->prevY[i] = w->startY[i];
+        w->vx[i] = 0; w->vy[i] = 0;
+    }
+
+    int clip = ANIM_IDLE;
+    if (w->flags[i] & ENT_DASHING) clip = ANIM_DASH;
+    else if (!(w->flags[i] & ENT_ON_GROUND)) clip = ANIM_AIR;
+    else if (fabsf(w->vx[i]) > 20) clip = ANIM_RUN;
+    PlayAnim(&w->anim[i], &w->animFrame[i], &w->animTimer[i], clip);
+}
+
+static void UpdateProjectile(World* w, const Level* level, int i, float dt) {
+    w->prevX[i] = w->x[i]; w->prevY[i] = w->y[i];
+    w->x[i] += w->vx[i] * dt;
+    w->y[i] += w->vy[i] * dt;
+    w->life[i] -= dt;
+    w->hit[i] = -1;
+
+    RectF box = { w->x[i], w->y[i], w->w[i], w->h[i] };
+    int contact;
+    if (w->life[i] <= 0 || LevelQuery(level, box, &contact, 1) > 0) w->flags[i] |= ENT_DEAD;
+}
+
+static void ActorRange(void* ctx, int begin, int end) {
+    StepContext* c = ctx;
+    World* w = c->w;
+    for (int i = begin; i < end; i++) {
+        if (w->kind[i] == ENT_ENEMY) UpdateEnemy(w, c->level, i, c->dt);
+        else if (w->kind[i] == ENT_PROJECTILE) UpdateProjectile(w, c->level, i, c->dt);
+    }
+    AdvanceAnims(w->anim + begin, w->animFrame + begin, w->animTimer + begin, end - begin, c->dt);
+}
+
+static void BuildBodyGrid(World* w) {
+    memset(w->bodyStart, 0, sizeof(w->bodyStart));
+    for (int i = 0; i < w->count; i++) {
+        uint32_t b = BodyBucket((int)floorf(w->x[i] / BODY_GRID_CELL), (int)floorf(w->y[i] / BODY_GRID_CELL));
+        w->bodyStart[b + 1]++;
+    }
+    for (int b = 0; b < BODY_GRID_BUCKETS; b++) w->bodyStart[b + 1] += w->bodyStart[b];
+
+    int fill[BODY_GRID_BUCKETS];
+    memcpy(fill, w->bodyStart, sizeof(fill));
+    for (int i = 0; i < w->count; i++) {
+        uint32_t b = BodyBucket((int)floorf(w->x[i] / BODY_GRID_CELL), (int)floorf(w->y[i] / BODY_GRID_CELL));
+        w->bodyItems[fill[b]++] = i;
+    }
+}
+
+static void HitRange(void* ctx, int begin, int end) {
+    StepContext* c = ctx;
+    World* w = c->w;
+    for (int i = begin; i < end; i++) {
+        if (w->kind[i] != ENT_PROJECTILE || (w->flags[i] & ENT_DEAD)) continue;
+        RectF box = { w->x[i], w->y[i], w->w[i], w->h[i] };
+        int x0 = (int)floorf((box.x - ENEMY_W) / BODY_GRID_CELL), x1 = (int)floorf((box.x + box.w) / BODY_GRID_CELL);
+        int y0 = (int)floorf((box.y - ENEMY_H) / BODY_GRID_CELL), y1 = (int)floorf((box.y + box.h) / BODY_GRID_CELL);
+        int best = -1;
+        for (int cy = y0; cy <= y1; cy++) {
+            for (int cx = x0; cx <= x1; cx++) {
+                uint32_t b = BodyBucket(cx, cy);
+                for (int k = w->bodyStart[b]; k < w->bodyStart[b + 1]; k++) {
+                    int e = w->bodyItems[k];
+                    if (best >= 0 && e >= best) break;
+                    if (w->kind[e] != ENT_ENEMY) continue;
+                    RectF r = { w->x[e], w->y[e], w->w[e], w->h[e] };
+                    if (checkCol(box, r)) best = e;
+                }
+            }
+        }
+        w->hit[i] = best;
+    }
+}
+
+static void MoveEntity(World* w, int dst, int src) {
+    w->kind[dst] = w->kind[src]; w->flags[dst] = w->flags[src];
+    w->x[dst] = w->x[src]; w->y[dst] = w->y[src];
+    w->prevX[dst] = w->prevX[src]; w->prevY[dst] = w->prevY[src];
+    w->vx[dst] = w->vx[src]; w->vy[dst] = w->vy[src];
+    w->w[dst] = w->w[src]; w->h[dst] = w->h[src];
+    w->startX[dst] = w->startX[src]; w->startY[dst] = w->startY[src];
+    w->coyoteTimer[dst] = w->coyoteTimer[src]; w->jumpBufferTimer[dst] = w->jumpBufferTimer[src];
+    w->dashTimer[dst] = w->dashTimer[src]; w->dashCooldownTimer[dst] = w->dashCooldownTimer[src];
+    w->thinkTimer[dst] = w->thinkTimer[src]; w->fireTimer[dst] = w->fireTimer[src];
+    w->dir[dst] = w->dir[src]; w->rng[dst] = w->rng[src];
+    w->rangeX[dst] = w->rangeX[src]; w->rangeY[dst] = w->rangeY[src];
+    w->period[dst] = w->period[src]; w->phase[dst] = w->phase[src];
+    w->life[dst] = w->life[src]; w->hit[dst] = w->hit[src];
+    w->anim[dst] = w->anim[src]; w->animFrame[dst] = w->animFrame[src]; w->animTimer[dst] = w->animTimer[src];
+}
+
+static void ResolveWorld(World* w) {
+    int n = w->count;
+    bool removed = false;
+    for (int i = 0; i < n; i++) {
+        if (w->kind[i] == ENT_PROJECTILE) {
+            int e = w->hit[i];
+            if (e >= 0 && !(w->flags[e] & ENT_HIT)) {
+                w->flags[e] |= ENT_HIT;
+                w->x[e] = w->prevX[e] = w->startX[e];
+                w->y[e] = w->prevY[e] = w->startY[e];
+                w->vx[e] = 0; w->vy[e] = 0;
+                w->flags[i] |= ENT_DEAD;
+            }
+            if (w->flags[i] & ENT_DEAD) removed = true;
+        } else if (w->kind[i] == ENT_ENEMY && (w->flags[i] & ENT_FIRE)) {
+            w->flags[i] &= ~ENT_FIRE;
+            float facing = (w->flags[i] & ENT_FACING_RIGHT) ? 1.0f : -1.0f;
+            float px = w->x[i] + (facing > 0 ? w->w[i] : -PROJECTILE_SIZE);
+            SpawnProjectile(w, px, w->y[i] + w->h[i] * 0.3f, facing * PROJECTILE_SPEED);
+        }
+    }
+
+    if (!removed) {
+        for (int i = 0; i < w->count; i++) w->flags[i] &= ~ENT_HIT;
+        return;
+    }
+
+    int out = 0;
+    w->numMovers = 0;
+    for (int i = 0; i < w->count; i++) {
+        if (w->flags[i] & ENT_DEAD) continue;
+        if (out != i) MoveEntity(w, out, i);
+        w->flags[out] &= ~ENT_HIT;
+        if (w->kind[out] == ENT_MOVER) w->movers[w->numMovers++] = out;
+        out++;
+    }
+    w->count = out;
+}
+
+void WorldStep(World* w, const Level* level, JobSystem* jobs, float dt) {
+    StepContext c = { w, level, dt };
+    w->tick++;
+
+    ParallelFor(jobs, w->numMovers, 64, MoverRange, &c);
+    BuildMoverGrid(w);
+    ParallelFor(jobs, w->count, WORLD_GRAIN, ActorRange, &c);
+    BuildBodyGrid(w);
+    ParallelFor(jobs, w->count, WORLD_GRAIN, HitRange, &c);
+    ResolveWorld(w);
+    BuildBodyGrid(w);
+}
+
+int QueryWorld(const World* w, RectF area, int* out, int maxOut) {
+    int x0 = (int)floorf((area.x - MAX_ENTITY_SIZE) / BODY_GRID_CELL), x1 = (int)floorf((area.x + area.w) / BODY_GRID_CELL);
+    int y0 = (int)floorf((area.y - MAX_ENTITY_SIZE) / BODY_GRID_CELL), y1 = (int)floorf((area.y + area.h) / BODY_GRID_CELL);
+    int n = 0;
+    for (int cy = y0; cy <= y1; cy++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            uint32_t b = BodyBucket(cx, cy);
+            for (int k = w->bodyStart[b]; k < w->bodyStart[b + 1]; k++) {
+                int e = w->bodyItems[k];
+                if ((int)floorf(w->x[e] / BODY_GRID_CELL) != cx || (int)floorf(w->y[e] / BODY_GRID_CELL) != cy) continue;
+                RectF r = { w->x[e], w->y[e], w->w[e], w->h[e] };
+                if (!checkCol(r, area)) continue;
+                if (n == maxOut) return n;
+                out[n++] = e;
+            }
+        }
+    }
+    return n;
+}
+
+static uint64_t HashBytes(uint64_t h, const void* data, size_t len) {
+    const unsigned char* b = data;
+    for (size_t i = 0; i < len; i++) { h ^= b[i]; h *= 0x100000001B3ull; }
+    return h;
+}
+
+uint64_t WorldHash(const World* w) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    size_t n = (size_t)w->count;
+    h = HashBytes(h, &w->tick, sizeof(w->tick));
+    h = HashBytes(h, &w->count, sizeof(w->count));
+    h = HashBytes(h, w->kind, n);
+    h = HashBytes(h, w->flags, n);
+    h = HashBytes(h, w->x, n * sizeof(float)); h = HashBytes(h, w->y, n * sizeof(float));
+    h = HashBytes(h, w->vx, n * sizeof(float)); h = HashBytes(h, w->vy, n * sizeof(float));
+    h = HashBytes(h, w->rng, n * sizeof(uint32_t));
+    return h;
+}
@@ -0,0 +1,91 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "jobs.h"
+#include "level.h"
+
+#define MAX_ENTITIES 16384
+#define MAX_MOVERS 256
+#define MAX_MOVER_CELLS (MAX_MOVERS * 16)
+#define WORLD_GRAIN 256
+#define MAX_ENTITY_SIZE 128.0f
+
+#define ENEMY_W 20
+#define ENEMY_H 40
+#define PROJECTILE_SIZE 6
+#define PROJECTILE_SPEED 600.0f
+#define PROJECTILE_LIFE 1.5f
+#define FIRE_COOLDOWN 2.0f
+
+#define BODY_GRID_BUCKETS 4096
+#define BODY_GRID_CELL 64.0f
+
+enum {
+    ENT_ENEMY,
+    ENT_PROJECTILE,
+    ENT_MOVER
+};
+
+enum {
+    ENT_ON_GROUND    = 1 << 0,
+    ENT_FACING_RIGHT = 1 << 1,
+    ENT_DASHING      = 1 << 2,
+    ENT_FIRE         = 1 << 3,
+    ENT_HIT          = 1 << 4,
+    ENT_DEAD         = 1 << 5
+};
+
+typedef struct {
+    int count;
+    int numMovers;
+    uint32_t seed;
+    uint64_t tick;
+
+    uint8_t kind[MAX_ENTITIES];
+    uint8_t flags[MAX_ENTITIES];
+    float x[MAX_ENTITIES], y[MAX_ENTITIES];
+    float prevX[MAX_ENTITIES], prevY[MAX_ENTITIES];
+    float vx[MAX_ENTITIES], vy[MAX_ENTITIES];
+    float w[MAX_ENTITIES], h[MAX_ENTITIES];
+    float startX[MAX_ENTITIES], startY[MAX_ENTITIES];
+
+    float coyoteTimer[MAX_ENTITIES];
+    float jumpBufferTimer[MAX_ENTITIES];
+    float dashTimer[MAX_ENTITIES];
+    float dashCooldownTimer[MAX_ENTITIES];
+
+    float thinkTimer[MAX_ENTITIES];
+    float fireTimer[MAX_ENTITIES];
+    int8_t dir[MAX_ENTITIES];
+    uint32_t rng[MAX_ENTITIES];
+
+    float rangeX[MAX_ENTITIES], rangeY[MAX_ENTITIES];
+    float period[MAX_ENTITIES], phase[MAX_ENTITIES];
+
+    float life[MAX_ENTITIES];
+    int32_t hit[MAX_ENTITIES];
+
+    uint8_t anim[MAX_ENTITIES];
+    uint8_t animFrame[MAX_ENTITIES];
+    float animTimer[MAX_ENTITIES];
+
+    int movers[MAX_MOVERS];
+    int bodyStart[BODY_GRID_BUCKETS + 1];
+    int bodyItems[MAX_ENTITIES];
+    int moverStart[BODY_GRID_BUCKETS + 1];
+    int moverItems[MAX_MOVER_CELLS];
+} World;
+
+void ClearWorld(World* w, uint32_t seed);
+int SpawnEnemy(World* w, float x, float y);
+int SpawnMover(World* w, float x, float y, float width, float height, float rangeX, float rangeY, float period);
+int SpawnProjectile(World* w, float x, float y, float vx);
+void PopulateWorld(World* w, const Level* level, int numEnemies);
+void WorldStep(World* w, const Level* level, JobSystem* jobs, float dt);
+int QueryWorld(const World* w, RectF area, int* out, int maxOut);
+uint64_t WorldHash(const World* w);
+
+#endif